@@ -8,6 +8,9 @@
  */
 
 #include "PlanarReflectorCPP.h"
+#include "ReflectionDiagnostics.h"
+#include "ReflectionScheduling.h"
+#include "ReflectionTrace.h"
 
 // Core Godot includes for basic functionality
 #include <godot_cpp/core/class_db.hpp> 
@@ -19,11 +22,24 @@
 #include <godot_cpp/classes/mesh_instance3d.hpp>
 #include <godot_cpp/classes/camera3d.hpp>
 #include <godot_cpp/classes/sub_viewport.hpp>
+#include <godot_cpp/classes/window.hpp>
+#include <godot_cpp/classes/world3d.hpp>
+#include <godot_cpp/classes/sky.hpp>
 #include <godot_cpp/classes/environment.hpp>
 #include <godot_cpp/classes/shader_material.hpp>
 #include <godot_cpp/classes/material.hpp>
 #include <godot_cpp/classes/viewport_texture.hpp>
 #include <godot_cpp/classes/camera_attributes.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/geometry_instance3d.hpp>
+#include <godot_cpp/classes/light3d.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/label3d.hpp>
+#include <godot_cpp/classes/standard_material3d.hpp>
+#include <godot_cpp/classes/immediate_mesh.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/shader.hpp>
 
 // Compositor system includes for advanced effects
 #include <godot_cpp/classes/compositor.hpp>
@@ -34,11 +50,46 @@
 // Math and utility includes
 #include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/vector4.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
 #include <godot_cpp/core/math.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <cstring>
 
 using namespace godot;
 
+// Process-wide registry and VRAM budget shared by all reflectors
+LocalVector<PlanarReflectorCPP *> PlanarReflectorCPP::registered_reflectors;
+int64_t PlanarReflectorCPP::vram_budget_bytes = 0;     // 0 = unlimited
+uint64_t PlanarReflectorCPP::last_budget_pass_frame = 0;
+
+// Scene content watched for static reflections, shared by all of them
+ReflectionContentTracker PlanarReflectorCPP::content_tracker;
+int PlanarReflectorCPP::content_tracker_users = 0;
+
+// CPU occlusion buffer and the occluders rasterized into it
+ReflectionOcclusionBuffer PlanarReflectorCPP::occlusion_buffer;
+uint64_t PlanarReflectorCPP::occlusion_camera_id = 0;
+uint64_t PlanarReflectorCPP::last_occlusion_pass_frame = 0;
+uint64_t PlanarReflectorCPP::occluder_list_frame = 0;
+LocalVector<uint64_t> PlanarReflectorCPP::occluder_node_ids;
+HashMap<uint64_t, PackedVector3Array> PlanarReflectorCPP::occluder_face_cache;
+
+// Baked potentially-visible sets, looked up once per frame
+Ref<ReflectorVisibilitySet> PlanarReflectorCPP::visibility_set;
+int PlanarReflectorCPP::visibility_cell = -1;
+uint64_t PlanarReflectorCPP::last_visibility_pass_frame = 0;
+bool PlanarReflectorCPP::visibility_indices_dirty = true;
+
+// Interleave column masks, one private render layer per interleaved reflector
+uint32_t PlanarReflectorCPP::interleave_mask_layers_in_use = 0;
+
+// Central wake-up scheduler for sleeping event-driven reflectors
+bool PlanarReflectorCPP::event_scheduler_connected = false;
+
+// Lightweight environments derived per source environment and tier
+HashMap<PlanarReflectorCPP::DerivedEnvironmentKey, PlanarReflectorCPP::DerivedEnvironment, PlanarReflectorCPP::DerivedEnvironmentKeyHasher> PlanarReflectorCPP::derived_environment_cache;
+
 PlanarReflectorCPP::PlanarReflectorCPP() 
 {  
     // Core functionality - enable by default for immediate visual feedback
@@ -50,10 +101,14 @@ PlanarReflectorCPP::PlanarReflectorCPP()
     ortho_scale_multiplier = 1.0;    // 1:1 scale for orthogonal cameras
     ortho_uv_scale = 1.0;            // No UV scaling by default
     auto_detect_camera_mode = true;  // Automatically match main camera projection
+    ortho_scroll_cache = false;      // Re-render orthogonal reflections on every update
+    ortho_cache_margin = 0.25;       // Cached render extends 25% of the view on each side
     
     // Rendering layers - default to layer 1 (most common setup)
     reflection_layers = 1;
     use_custom_environment = false;  // Use generated environment for consistency
+    derive_environment_from_camera = false;  // Off = fixed clear-colour environment
+    reflection_environment_tier = 1;         // Medium - keeps glow, drops screen-space and GI effects
     
     // Compositor Effects - Enable for advanced reflection masking
     hide_intersect_reflections = true;      // Hide geometry intersecting the reflection plane (EXPERIMENTAL Hide underwater objects)
@@ -74,11 +129,68 @@ PlanarReflectorCPP::PlanarReflectorCPP()
     lod_distance_near = 10.0;           // Full quality within 10 units
     lod_distance_far = 25.0;            // Minimum quality beyond 25 units
     lod_resolution_multiplier = 0.45;   // Reduce to 45% resolution when far
+    min_reflection_size = 128;          // Never shrink below 128x128
+
+    // Roughness-aware resolution - mirror-like surfaces keep full resolution
+    surface_roughness = 0.0;                // Perfectly sharp reflection
+    auto_detect_roughness = true;           // Read "reflection_roughness" from the ShaderMaterial when present
+    roughness_min_resolution_scale = 0.125; // Fully rough surfaces render at 1/8 resolution
+    detected_roughness = -1.0;              // No roughness read from the material yet
+
+    // Content-change tracking - continuous rendering unless enabled
+    static_until_changed = false;       // Re-render every frame by default
+    auto_track_reflected_nodes = true;  // Track geometry on reflection_layers and all lights automatically
+    max_staleness = 5.0;                // Re-render at least every 5 seconds in static mode
+    pose_cache = false;                 // Every return to a pose re-renders
+    pose_cache_memory_mb = 64;          // Parked renders may use up to 64 MB
+
+    // VRAM budget - medium priority, counted as visible until proven otherwise
+    reflection_priority = 50;
+    is_visible_to_active_camera = true;
+    budget_evicted = false;
+
+    // Rig lifetime - allocate at startup and keep for the node's lifetime by default
+    lazy_rig_allocation = false;        // Allocate the SubViewport in _ready()
+    rig_release_timeout = 0.0;          // Never release the rig while invisible
+    rig_setup_started = false;
+    prewarm_on_ready = false;           // Pipelines compile on first visibility
+    prewarm_requested = false;
+    prewarm_in_progress = false;
+    prewarm_frame = 0;
     
     // Internal state initialization
     frame_counter = 0;                  // Tracks frames for update frequency
     position_threshold = 0.01;          // Minimum movement for updates (unused in current implementation)
     rotation_threshold = 0.001;         // Minimum rotation for updates (unused in current implementation)
+    camera_cut_distance = 5.0;          // Camera jumps further than 5 units in one frame count as a cut
+    camera_cut_angle = 45.0;            // Camera turns more than 45 degrees in one frame count as a cut
+    use_instance_uniforms = false;      // Reflection state goes into the material(s)
+    predictive_camera = false;          // Mirror the current pose, not an extrapolated one
+    prediction_overscan = 0.1;          // 10% wider render when extrapolating
+
+    // Reflection clip range - opt-in, near plane at the mirror, optional far limit
+    tight_reflection_clip = false;      // Keep the source near plane (intersect pass clips instead)
+    reflection_draw_distance = 0.0;     // 0 = same far plane as the source camera
+
+    // Empty-mirror fast path - skip the scene pass when nothing is in the mirrored frustum
+    skip_empty_reflections = false;     // Opt-in, the shader needs an environment-only branch
+
+    // Occlusion culling - opt-in, needs OccluderInstance3D nodes or "reflection_occluders" meshes
+    occlusion_culling = false;
+
+    // Interleaved rendering - opt-in, half the columns per frame
+    interleaved_rendering = false;
+
+    // Double-buffered targets - opt-in, the material samples the last completed render
+    double_buffered_reflections = false;
+
+    // Event-driven processing - opt-in, idle reflectors stop receiving _process
+    event_driven = false;
+
+    // Split-screen - extra views are rendered round-robin
+    split_screen_updates_per_frame = 1; // One extra view rendered per frame
+    split_screen_pixel_budget = 0;      // No cap on the combined size of the extra views
+    split_screen_first_layer = 17;      // Players' copies of the mesh use layers 17-20
     is_layer_one_active = true;         // Tracks if layer 1 is in reflection_layers
     
     // Performance optimization caches
@@ -90,6 +202,29 @@ PlanarReflectorCPP::PlanarReflectorCPP()
 
 PlanarReflectorCPP::~PlanarReflectorCPP() 
 {
+    // Never leave a dangling pointer in the process-wide registry
+    registered_reflectors.erase(this);
+    free_interleave_mask();
+}
+
+/**
+ * @brief Registers the reflector for process-wide VRAM accounting
+ */
+void PlanarReflectorCPP::_enter_tree()
+{
+    if (registered_reflectors.find(this) < 0) {
+        registered_reflectors.push_back(this);
+        visibility_indices_dirty = true;  // Find this reflector in the baked set
+    }
+
+    // Re-added after _exit_tree - first entries watch content from finalize_setup
+    if (static_until_changed && reflect_viewport) {
+        acquire_content_tracker();
+    }
+
+    // _exit_tree forgot any sleep - process again and redo the checks sleepers skip
+    set_process(true);
+    wake_checks_pending = true;
 }
 
 void PlanarReflectorCPP::_ready() 
@@ -98,7 +233,16 @@ void PlanarReflectorCPP::_ready()
     add_to_group("planar_reflectors");
     // Clear any existing shader references to prevent texture leaks and shader references breaking
     clear_shader_texture_references();
+    // Prewarming needs the rig at load time, lazy or not
+    if (prewarm_on_ready) {
+        prewarm_requested = true;
+    }
+    // Lazy reflectors allocate their rig when first seen (see update_rig_lifetime)
+    if (lazy_rig_allocation && !prewarm_requested) {
+        return;
+    }
     // Defer main setup to next frame to ensure scene tree is fully constructed
+    rig_setup_started = true;
     call_deferred("initial_setup");
 }
 
@@ -111,18 +255,12 @@ void PlanarReflectorCPP::_ready()
 void PlanarReflectorCPP::_notification(int what)
 {
     if (what == NOTIFICATION_TRANSFORM_CHANGED) {
-        // Only update if we have a valid reflection camera with compositor
-        if (reflect_camera && reflect_camera->get_compositor().is_valid()) 
-        {
-            // Update viewport size in case screen resolution changed
-            update_reflect_viewport_size();
-            
-            // Recalculate reflection camera position and orientation
-            set_reflection_camera_transform();
-            
-            // Update compositor effect parameters (e.g., intersection height)
-            update_compositor_parameters();
-        }
+        // Animated or physics-driven parents can send several of these per frame -
+        // only mark dirty, _process runs one consolidated update
+        reflector_transform_dirty = true;
+
+        // A moved reflector needs its regular updates again
+        wake_reflector();
     }
 }
 
@@ -169,6 +307,16 @@ void PlanarReflectorCPP::finalize_setup()
     
     // Calculate and set initial reflection camera transform
     set_reflection_camera_transform();
+
+    // Start watching scene content when static reflections are enabled
+    if (static_until_changed) {
+        acquire_content_tracker();
+    }
+
+    // Requested before the rig existed (prewarm_on_ready or an early prewarm_reflection call)
+    if (prewarm_requested) {
+        start_prewarm_render();
+    }
 }
 
 /**
@@ -181,249 +329,1454 @@ void PlanarReflectorCPP::finalize_setup()
 void PlanarReflectorCPP::_process(double delta) 
 {
     // Early exit if not ready or disabled - saves CPU cycles
-    if (!is_inside_tree() || !is_active) {
+    if (!is_inside_tree()) {
         return;
     }
-     
-    frame_counter++;  // Track frames for frequency-based updates
-    
-    // Periodically check if viewport size needs updating
-    if (viewport_check_frequency > 0 && frame_counter % viewport_check_frequency == 0) {
-        update_reflect_viewport_size();
+
+    // Inactive reflectors stop processing entirely until set_is_active(true)
+    if (!is_active) {
+        enter_process_sleep();
+        return;
     }
-    
-    // Update reflection camera at configured frequency
-    bool should_update = (update_frequency > 0 && frame_counter % update_frequency == 0);
 
-    if (should_update) {
-        Camera3D *active_cam = get_active_camera();
-        if (active_cam) {
-            // Recalculate reflection camera position and update shader parameters
-            set_reflection_camera_transform();
+    if (trace_file.is_null()) {
+        process_reflection(delta);
+        if (can_sleep()) {
+            enter_process_sleep();
         }
+        return;
     }
+
+    // Trace capture: time the reflector's own work and record what it decided
+    uint64_t start_usec = Time::get_singleton()->get_ticks_usec();
+    uint32_t trace_flags = process_reflection(delta);
+    write_trace_record(delta, trace_flags, Time::get_singleton()->get_ticks_usec() - start_usec);
 }
 
 /**
- * @brief Creates the reflection viewport and camera system
+ * @brief One frame of reflector work - scheduling, sizing, budget and updates
  * 
- * This is the core setup function that creates:
- * 1. SubViewport for rendering reflections
- * 2. Camera3D for capturing the reflected view
- * 3. Proper cleanup of any existing system
+ * @param delta Time elapsed since last frame
+ * @return uint32_t ReflectionTraceFlags for what happened (updated, camera cut)
  */
-void PlanarReflectorCPP::setup_reflection_camera_and_viewport()
+uint32_t PlanarReflectorCPP::process_reflection(double delta)
 {
-    // CRITICAL: Clear shader texture references before destroying viewport
-    // This prevents crashes from dangling texture pointers in materials
-    clear_shader_texture_references();
+    frame_counter++;  // Track frames for frequency-based updates
+    time_since_render += delta;  // Staleness timer for static reflections
+
+    // Cost of what rendered last frame, and the overlay that shows it
+    accumulate_render_cost(delta);
+
+    // Prewarm render drawn - back to the real size and schedule
+    if (prewarm_in_progress) {
+        finish_prewarm_render();
+    }
     
-    // Safe cleanup of existing reflection viewport
-    if (reflect_viewport) {
-        if (reflect_viewport->is_inside_tree()) {
-            reflect_viewport->get_parent()->remove_child(reflect_viewport);
+    // Outside the baked potentially-visible set of the camera's cell - nothing else to do
+    apply_reflector_visibility_set(get_active_camera());
+    if (pvs_culled) {
+        return 0;
+    }
+
+    // Periodically check visibility, rig lifetime, viewport size and the global VRAM budget
+    // (and right after waking, since sleepers skipped those checks)
+    if ((viewport_check_frequency > 0 && frame_counter % viewport_check_frequency == 0) || wake_checks_pending) {
+        wake_checks_pending = false;
+        last_viewport_check_frame = frame_counter - viewport_check_frequency;
+        update_visibility_state();
+        update_rig_lifetime();
+        if (reflect_viewport) {
+            sync_interleave_rig();
+            sync_double_buffer_rig();
+            if (!is_pose_cache_active()) {
+                flush_pose_cache();
+            }
+            update_reflect_viewport_size();
+            sync_split_screen_views();
+            update_split_screen_view_sizes();
         }
-        reflect_viewport->queue_free();  // Godot's safe deletion method
-        reflect_viewport = nullptr;
+        enforce_vram_budget();
     }
-    
-    // Camera will be freed automatically when viewport is destroyed
-    if (reflect_camera) {
-        reflect_camera = nullptr;
+
+    // Follow edits to the main environment (rebuilt only when its fingerprint changes)
+    if (derive_environment_from_camera && !use_custom_environment && reflect_camera &&
+            viewport_check_frequency > 0 && frame_counter % viewport_check_frequency == 0) {
+        refresh_derived_environment();
     }
 
-    // PERFORMANCE: Wait one frame before creating new viewport
-    // This prevents rapid create/destroy cycles during initialization
-    if (frame_counter > 0) {
-        call_deferred("create_viewport_deferred");
-        return;
+    // No rig allocated yet (lazy) or released while invisible - nothing to update
+    if (!reflect_viewport) {
+        return 0;
+    }
+
+    // Last frame's back buffer render is complete - sample it from now on
+    swap_reflection_buffers();
+
+    // Hidden behind walls - stop rendering until revealed
+    update_occlusion_state();
+
+    // Camera cuts refresh everything this frame, skipping the throttled update
+    if (detect_camera_cut()) {
+        force_reflection_refresh();
+        return REFLECTION_TRACE_CAMERA_CUT | REFLECTION_TRACE_UPDATED;
     }
+
+    uint32_t trace_flags = 0;
     
-    // First frame - create immediately
-    create_viewport_deferred();
+    // Update reflection camera at configured frequency - or right away when the reflector moved
+    bool should_update = ReflectionScheduling::is_update_frame(frame_counter, update_frequency);
+    bool transform_moved = reflector_transform_dirty;
+    reflector_transform_dirty = false;
+
+    if (transform_moved && reflect_camera && reflect_camera->get_compositor().is_valid()) {
+        // Viewport size may follow the new distance; intersection height follows the new plane
+        update_reflect_viewport_size();
+        update_compositor_parameters();
+    }
+
+    if (should_update || transform_moved) {
+        Camera3D *active_cam = get_active_camera();
+        if (active_cam) {
+            // Recalculate reflection camera position and update shader parameters
+            set_reflection_camera_transform();
+            trace_flags |= REFLECTION_TRACE_UPDATED;
+
+            // The view this update was based on - sleepers wake when it changes
+            wake_update_pending = false;
+            sleep_camera_transform = active_cam->get_global_transform();
+        }
+    }
+
+    // Interleaved rendering: the other half of the columns renders this frame
+    advance_interleave_phase();
+
+    // Split-screen views render round-robin within their per-frame budget
+    update_split_screen_views();
+    return trace_flags;
+}
+
+// Full-screen quad just past the near plane (reversed Z) that fills the depth buffer on the
+// columns of the phase not being rendered, so early depth testing skips shading them.
+// It sits on a render layer only this reflector's phase cameras cull in.
+static const char *INTERLEAVE_MASK_SHADER_CODE = R"(
+shader_type spatial;
+render_mode unshaded, cull_disabled, depth_draw_always, shadows_disabled;
+
+uniform int mask_open_parity;
+
+void vertex() {
+    POSITION = vec4(VERTEX.xy * 2.0, 0.9999, 1.0);
+}
+
+void fragment() {
+    if (int(FRAGCOORD.x) % 2 == mask_open_parity) {
+        discard;
+    }
+    ALBEDO = vec3(0.0);
 }
+)";
 
 /**
- * @brief Deferred viewport creation - Ensures safe initialization
+ * @brief Interleaving only pays off for continuously rendered, standalone targets
  */
-void PlanarReflectorCPP::create_viewport_deferred()
+bool PlanarReflectorCPP::is_interleave_wanted() const
 {
-    // Create SubViewport with unique name to avoid conflicts
-    reflect_viewport = memnew(SubViewport);
-    String unique_name = "ReflectionViewPort";
-    reflect_viewport->set_name(unique_name);
-    
-    // Add as child - this viewport will render our reflection
-    add_child(reflect_viewport);
-    
-    // Configure viewport for reflection rendering
-    reflect_viewport->set_size(reflection_camera_resolution);           // Set target resolution
-    reflect_viewport->set_update_mode(SubViewport::UPDATE_ALWAYS);      // Continuous updates
-    reflect_viewport->set_msaa_3d(Viewport::MSAA_DISABLED);             // MSAA off for performance
-    reflect_viewport->set_positional_shadow_atlas_size(2048);           // Decent shadow quality
-    reflect_viewport->set_use_own_world_3d(false);                      // Share world with main scene
-    reflect_viewport->set_transparent_background(true);                 // Allow alpha blending
-    reflect_viewport->set_handle_input_locally(false);                  // No input needed
+    return interleaved_rendering && reflect_viewport && !budget_evicted &&
+            !uses_on_demand_rendering() && !double_buffered_reflections;
+}
 
-    // Create the reflection camera
-    reflect_camera = memnew(Camera3D);
-    reflect_camera->set_name("ReflectCamera");
-    reflect_viewport->add_child(reflect_camera);
-    
-    // Configure camera layer visibility
-    int cull_mask = reflection_layers;
-    reflect_camera->set_cull_mask(cull_mask);
-    
-    // Check if layer 1 is active (important for lighting)
-    is_layer_one_active = bool(cull_mask & (1 << 0));
-    
-    // Copy properties from main camera if available
-    if (main_camera) {
-        reflect_camera->set_attributes(main_camera->get_attributes());      // Copy camera attributes
-        reflect_camera->set_doppler_tracking(main_camera->get_doppler_tracking());  // Copy audio settings
+bool PlanarReflectorCPP::is_interleaving_active() const
+{
+    return interleave_viewport != nullptr && is_interleave_wanted();
+}
+
+/**
+ * @brief Creates or frees the second phase rig to match is_interleave_wanted()
+ */
+void PlanarReflectorCPP::sync_interleave_rig()
+{
+    if (!is_interleave_wanted()) {
+        free_interleave_rig();
+        return;
     }
-    
-    // Make this camera active for its viewport
-    reflect_camera->set_current(true);
-    
-    // Setup environment and compositor effects
-    setup_reflection_environment();
-    
-    // Setup compositor effects for advanced reflection features
-    if (reflect_camera) {
-        call_deferred("setup_compositor_reflection_effect", reflect_camera);
+    if (interleave_viewport) {
+        return;
     }
+
+    interleave_viewport = create_reflection_subviewport("ReflectionViewPortPhaseB", interleave_camera);
+    interleave_viewport->set_update_mode(SubViewport::UPDATE_DISABLED);
+    interleave_camera->set_environment(reflect_camera->get_environment());
+    interleave_camera->set_compositor(reflect_camera->get_compositor());
+
+    // Phases take over from continuous rendering of the primary target
+    reflect_viewport->set_update_mode(SubViewport::UPDATE_DISABLED);
+    interleave_phase = 0;
+    last_viewport_check_frame = frame_counter - viewport_check_frequency;  // Size the phase target now
+    invalidate_reflection_cache();
 }
 
 /**
- * @brief Configures the reflection camera's rendering environment
- * 
- * Sets up the Environment resource that controls:
- * - Background rendering (clear color vs skybox)
- * - Ambient lighting settings
- * - Fog and atmospheric effects
+ * @brief Frees the second phase rig and its column mask
  */
-void PlanarReflectorCPP::setup_reflection_environment()
+void PlanarReflectorCPP::free_interleave_rig()
 {
-    if (!reflect_camera) {
+    if (!interleave_viewport) {
         return;
     }
 
-    // Apply environment to reflection camera
-    // Use custom environment if specified
-    if (use_custom_environment && custom_environment.is_valid()) {
-        reflect_camera->set_environment(custom_environment);
-        // UtilityFunctions::print("[PlanarReflectorCPP] Camera Reflection -> set using Custom Editor Environment");
-    } else {
-        // Create default environment optimized for reflections
-        Ref<Environment> reflection_env;
-        reflection_env.instantiate();
-        reflection_env->set_background(Environment::BG_CLEAR_COLOR);        // Clear background
-        reflection_env->set_ambient_source(Environment::AMBIENT_SOURCE_COLOR);  // Use ambient color
-        reflection_env->set_ambient_light_color(Color(0.8, 0.8, 0.8));     // Neutral gray
-        reflection_env->set_ambient_light_energy(1.0);     
-        
-        reflect_camera->set_environment(reflection_env);// Standard intensity
-        // UtilityFunctions::print("[PlanarReflectorCPP] Camera Reflection -> set using Default Environment");
+    if (interleave_viewport->is_inside_tree()) {
+        interleave_viewport->get_parent()->remove_child(interleave_viewport);
     }
+    interleave_viewport->queue_free();
+    interleave_viewport = nullptr;
+    interleave_camera = nullptr;
+    free_interleave_mask();
+    if (reflect_camera) {
+        reflect_camera->set_cull_mask(reflection_layers);  // Drop the mask layer
+    }
+
+    // The primary target renders every column again
+    invalidate_reflection_cache();
 }
 
 /**
- * @brief Locates the editor helper singleton for viewport size detection (required for Editor Cam and ViewPortSync)
+ * @brief Gives the phase B camera the primary's view
  * 
- * In editor mode, we need to detect the size of the 3D viewport
- * window to match reflection resolution to the editor view.
- * This function finds the PlanarReflectorEditorHelper singleton
- * that provides this functionality.
+ * Both phases render the same full-resolution pixel grid, so no jitter is
+ * needed: phase A shades the even columns, phase B the odd ones.
  */
-void PlanarReflectorCPP::find_editor_helper()
+void PlanarReflectorCPP::update_interleave_camera(Camera3D *source_cam)
 {
-    if (Engine::get_singleton()->is_editor_hint()) {
-        // Check if the editor helper singleton is registered
-        if (Engine::get_singleton()->has_singleton("PlanarReflectorEditorHelper")) {
-            editor_helper = Engine::get_singleton()->get_singleton("PlanarReflectorEditorHelper");
-        }
-    }
+    interleave_camera->set_global_transform(reflect_camera->get_global_transform());
+    interleave_camera->set_cull_mask(reflect_camera->get_cull_mask());
+    copy_camera_projection(source_cam, interleave_camera, get_ortho_cache_extent_scale());
+    apply_prediction_overscan(interleave_camera);
+    interleave_camera->set_near(reflect_camera->get_near());
+    interleave_camera->set_far(reflect_camera->get_far());
 }
 
 /**
- * @brief Sets up compositor effects for advanced reflection features
+ * @brief Creates the column mask instance in the reflector's world
  * 
- * The Compositor system in Godot 4.4+ allows post-processing effects
- * to be applied to camera rendering. For reflections, we use it to:
- * - Hide geometry that intersects the reflection plane
- * - Fill gaps in reflections (experimental feature)
- * - Adjust reflection appearance at the pixel level
- * @param reflect_cam The reflection camera to apply effects to
+ * Halving the target width instead would halve the horizontal field of
+ * view, since cameras derive it from the target's aspect ratio. The mask
+ * takes a free layer from INTERLEAVE_MASK_LAYERS so no other camera - the
+ * main one or another reflector's, even on the same plane - draws it.
+ * With every layer taken the phases render all columns, unmasked.
  */
-void PlanarReflectorCPP::setup_compositor_reflection_effect(Camera3D *reflect_cam) 
+void PlanarReflectorCPP::create_interleave_mask()
 {
-    if (!reflect_cam) {
+    Ref<World3D> world = get_world_3d();
+    if (interleave_mask_instance.is_valid() || world.is_null()) {
         return;
     }
-    
-    // Priority 1: Use explicitly set compositor
-    if(active_compositor.is_valid() && (reflect_cam->get_compositor() != active_compositor))
-    {
-        reflect_cam->set_compositor(active_compositor);
-        update_compositor_parameters();  // Configure effect parameters
+
+    uint32_t free_layers = INTERLEAVE_MASK_LAYERS & ~interleave_mask_layers_in_use;
+    if (free_layers == 0) {
         return;
     }
+    interleave_mask_layer_bit = free_layers & (~free_layers + 1);  // Lowest free layer
+    interleave_mask_layers_in_use |= interleave_mask_layer_bit;
 
-    // Priority 2: Create new compositor if camera doesn't have one
-    Ref<Compositor> current_comp = reflect_cam->get_compositor();
-    if (!current_comp.is_valid() || current_comp->get_compositor_effects().size() == 0) {
-        // Load compositor from resource file and assign to camera
-        active_compositor = create_new_compositor();
-        reflect_cam->set_compositor(active_compositor);
-        update_compositor_parameters();
-        return;
+    if (interleave_mask_material.is_null()) {
+        Ref<Shader> shader;
+        shader.instantiate();
+        shader->set_code(INTERLEAVE_MASK_SHADER_CODE);
+        interleave_mask_material.instantiate();
+        interleave_mask_material->set_shader(shader);
+        interleave_mask_mesh.instantiate();
+    }
+
+    RenderingServer *rs = RenderingServer::get_singleton();
+    interleave_mask_instance = rs->instance_create2(interleave_mask_mesh->get_rid(), world->get_scenario());
+    rs->instance_geometry_set_material_override(interleave_mask_instance, interleave_mask_material->get_rid());
+    rs->instance_geometry_set_cast_shadows_setting(interleave_mask_instance, RenderingServer::SHADOW_CASTING_SETTING_OFF);
+    rs->instance_set_custom_aabb(interleave_mask_instance, AABB(Vector3(-1e6, -1e6, -1e6), Vector3(2e6, 2e6, 2e6)));  // Never frustum culled
+    rs->instance_set_layer_mask(interleave_mask_instance, interleave_mask_layer_bit);
+}
+
+void PlanarReflectorCPP::free_interleave_mask()
+{
+    if (interleave_mask_instance.is_valid()) {
+        RenderingServer::get_singleton()->free_rid(interleave_mask_instance);
+        interleave_mask_instance = RID();
     }
+    interleave_mask_layers_in_use &= ~interleave_mask_layer_bit;
+    interleave_mask_layer_bit = 0;
 }
 
 /**
- * @brief Creates a new compositor by loading from resource file
- * Loads the reflection compositor effect from a .tres resource file
- * that contains pre-configured CompositorEffect settings. The resource
- * is duplicated to ensure each reflection camera gets its own instance.
- * 
- * @return Ref<Compositor> New compositor instance, or empty ref if loading fails
+ * @brief Opens the phase camera's own columns and masks the others
  */
-Ref<Compositor> PlanarReflectorCPP::create_new_compositor() 
+void PlanarReflectorCPP::update_interleave_mask(Camera3D *phase_camera)
 {
-    // Load the pre-configured reflection compositor resource
-    Variant loaded_resource = ResourceLoader::get_singleton()->load("res://addons/PlanarReflectorCpp/SupportFiles/reflection_compositor.tres");
-    
-    if (loaded_resource.get_type() == Variant::OBJECT) 
-    {
-        // CRITICAL: Create a unique copy using duplicate(true) for deep copy
-        // This ensures each camera gets its own effect instance
-        Ref<Resource> resource_ref = loaded_resource;
-        if (resource_ref.is_valid()) 
-        {
-            Ref<Resource> unique_copy = resource_ref->duplicate(true); // Deep copy
-            Ref<Compositor> compositor = Object::cast_to<Compositor>(unique_copy.ptr());
-            return compositor;
-        }
-    } 
+    create_interleave_mask();  // Created lazily, freed on tree exit
+    if (!interleave_mask_instance.is_valid()) {
+        return;
+    }
 
-    // Return empty compositor if loading fails
-    return Ref<Compositor>();
+    // Only the phase cameras cull in the mask's layer
+    uint32_t cull_mask = (uint32_t)reflection_layers | interleave_mask_layer_bit;
+    if (phase_camera->get_cull_mask() != cull_mask) {
+        phase_camera->set_cull_mask(cull_mask);
+    }
+    interleave_mask_material->set_shader_parameter("mask_open_parity", interleave_phase);
 }
 
 /**
- * @brief Updates compositor effect parameters with current reflection settings
+ * @brief Renders the other phase this frame and tells the shader which one is fresh
  * 
- * Configures the compositor effect with reflection-specific parameters:
- * - effect_enabled: Whether the effect should be active
- * - fill_enabled: Whether to use experimental gap filling
- * - intersect_height: Y-coordinate of the reflection plane
+ * The stale phase's mirrored transform goes to the shader as
+ * reflection_previous_transform, so it can fall back to the fresh phase
+ * alone where the view moved since the stale one was rendered.
  */
-void PlanarReflectorCPP::update_compositor_parameters()
+void PlanarReflectorCPP::advance_interleave_phase()
 {
-    if (!active_compositor.is_valid()) return;
-    
-    // Get the first compositor effect (our reflection effect)
+    if (!is_interleaving_active() || reflection_empty || reflection_occluded) {
+        return;
+    }
+
+    interleave_phase ^= 1;
+    SubViewport *phase_viewport = interleave_phase == 0 ? reflect_viewport : interleave_viewport;
+    Camera3D *phase_camera = interleave_phase == 0 ? reflect_camera : interleave_camera;
+
+    update_interleave_mask(phase_camera);
+    phase_viewport->set_update_mode(SubViewport::UPDATE_ONCE);
+    count_reflection_render(phase_viewport->get_size());
+
+    interleave_previous_transform = interleave_phase_transforms[interleave_phase ^ 1];
+    interleave_phase_transforms[interleave_phase] = phase_camera->get_global_transform();
+
+    LocalVector<ShaderMaterial *> materials;
+    if (gather_reflection_materials(materials)) {
+        set_reflection_parameter(materials, "reflection_interleave_phase", interleave_phase);
+        set_reflection_parameter(materials, "reflection_previous_transform", interleave_previous_transform);
+    }
+}
+
+/**
+ * @brief Phase B texture, full resolution and reconstruction data for the shader
+ */
+void PlanarReflectorCPP::push_interleave_shader_parameters(const LocalVector<ShaderMaterial *> &materials)
+{
+    bool active = is_interleaving_active();
+    set_reflection_parameter(materials, "reflection_interleaved", active);
+    if (!active) {
+        return;
+    }
+
+    set_reflection_parameter(materials, "reflection_phase_b_texture", interleave_viewport->get_texture());
+    set_reflection_parameter(materials, "reflection_full_size", Vector2(interleave_full_size));
+    set_reflection_parameter(materials, "reflection_interleave_phase", interleave_phase);
+    set_reflection_parameter(materials, "reflection_previous_transform", interleave_previous_transform);
+}
+
+/**
+ * @brief Double buffering needs a full target - evicted reflectors keep a minimal one
+ */
+bool PlanarReflectorCPP::is_double_buffer_wanted() const
+{
+    return double_buffered_reflections && reflect_viewport && !budget_evicted;
+}
+
+bool PlanarReflectorCPP::is_double_buffering_active() const
+{
+    return front_buffer_viewport != nullptr && is_double_buffer_wanted();
+}
+
+/**
+ * @brief Adds or removes the second target to match is_double_buffer_wanted()
+ * 
+ * The existing target already holds a finished image, so it becomes the
+ * front buffer and the new target starts as the back buffer.
+ */
+void PlanarReflectorCPP::sync_double_buffer_rig()
+{
+    if (!is_double_buffer_wanted()) {
+        if (front_buffer_viewport) {
+            free_double_buffer_rig();
+            apply_viewport_update_mode();
+            update_shader_parameters();
+        }
+        return;
+    }
+    if (front_buffer_viewport) {
+        return;
+    }
+
+    Camera3D *back_camera = nullptr;
+    SubViewport *back_viewport = create_reflection_subviewport("ReflectionViewPortBack", back_camera);
+    back_viewport->set_update_mode(SubViewport::UPDATE_DISABLED);
+    back_viewport->set_size(reflect_viewport->get_size());
+    back_camera->set_environment(reflect_camera->get_environment());
+    back_camera->set_compositor(reflect_camera->get_compositor());
+    back_camera->set_global_transform(reflect_camera->get_global_transform());
+
+    front_buffer_viewport = reflect_viewport;
+    front_buffer_camera = reflect_camera;
+    reflect_viewport = back_viewport;
+    reflect_camera = back_camera;
+
+    // The front buffer keeps its last image - it only renders again as a back buffer
+    front_buffer_viewport->set_update_mode(SubViewport::UPDATE_DISABLED);
+    buffer_swap_pending = false;
+    update_camera_projection();
+    request_reflection_render();
+    update_shader_parameters();
+}
+
+/**
+ * @brief Frees the back buffer and makes the front buffer the only target again
+ * 
+ * Leaves update mode and shader parameters to the caller, since the rig
+ * release path must not hand the texture back to the material.
+ */
+void PlanarReflectorCPP::free_double_buffer_rig()
+{
+    if (!front_buffer_viewport) {
+        return;
+    }
+
+    if (reflect_viewport) {
+        if (reflect_viewport->is_inside_tree()) {
+            reflect_viewport->get_parent()->remove_child(reflect_viewport);
+        }
+        reflect_viewport->queue_free();
+    }
+    reflect_viewport = front_buffer_viewport;
+    reflect_camera = front_buffer_camera;
+    front_buffer_viewport = nullptr;
+    front_buffer_camera = nullptr;
+    buffer_swap_pending = false;
+}
+
+/**
+ * @brief Makes the back buffer the sampled one once its render has completed
+ * 
+ * A single render scheduled on frame N is drawn at the end of frame N, so
+ * from frame N + 1 on it is complete and the main pass can sample it with
+ * no dependency on a reflection pass of the same frame.
+ */
+void PlanarReflectorCPP::swap_reflection_buffers()
+{
+    if (!buffer_swap_pending || frame_counter <= buffer_render_frame) {
+        return;
+    }
+    buffer_swap_pending = false;
+    if (!is_double_buffering_active()) {
+        return;
+    }
+
+    SWAP(reflect_viewport, front_buffer_viewport);
+    SWAP(reflect_camera, front_buffer_camera);
+
+    // Settings changed since the last swap were applied to the old back camera only
+    reflect_camera->set_environment(front_buffer_camera->get_environment());
+    reflect_camera->set_compositor(front_buffer_camera->get_compositor());
+    reflect_camera->set_cull_mask(front_buffer_camera->get_cull_mask());
+    if (reflect_viewport->get_size() != front_buffer_viewport->get_size()) {
+        reflect_viewport->set_size(front_buffer_viewport->get_size());
+    }
+
+    update_shader_parameters();
+}
+
+/**
+ * @brief The target the material samples - the front buffer when double-buffered
+ */
+SubViewport *PlanarReflectorCPP::get_sampled_viewport() const
+{
+    return is_double_buffering_active() ? front_buffer_viewport : reflect_viewport;
+}
+
+/**
+ * @brief Whether nothing needs this reflector's _process until an event arrives
+ * 
+ * A reflector may sleep once its last camera move has been applied and no
+ * render, buffer swap, cut or deferred work is pending. Features that poll every frame
+ * (tracked content, split-screen round-robin, trace capture, cost overlay)
+ * keep it awake.
+ */
+bool PlanarReflectorCPP::can_sleep() const
+{
+    if (!event_driven || wake_update_pending || camera_cut_pending || reflection_render_requested || prewarm_in_progress) {
+        return false;
+    }
+    if (!split_screen_views.is_empty() || trace_file.is_valid() || show_cost_overlay) {
+        return false;
+    }
+    if (static_until_changed && content_tracker.get_node_count() > 0) {
+        return false;  // Tracked nodes are polled
+    }
+    if (is_single_render_pending()) {
+        return false;  // Let the pending single render go through first
+    }
+    if (buffer_swap_pending) {
+        return false;  // The back buffer is presented on a later frame
+    }
+    return true;
+}
+
+/**
+ * @brief Turns off _process; the central scheduler or an event wakes us again
+ */
+void PlanarReflectorCPP::enter_process_sleep()
+{
+    if (process_sleeping) {
+        return;
+    }
+
+    process_sleeping = true;
+    sleep_started_usec = Time::get_singleton()->get_ticks_usec();
+    set_process(false);
+
+    if (event_driven) {
+        connect_event_scheduler();
+    }
+}
+
+/**
+ * @brief Resumes _process and schedules a regular update on the next throttled frame
+ */
+void PlanarReflectorCPP::wake_reflector()
+{
+    wake_update_pending = true;
+    if (!process_sleeping || !is_active) {
+        return;
+    }
+
+    process_sleeping = false;
+    wake_checks_pending = true;
+    set_process(true);
+}
+
+/**
+ * @brief Runs once per frame for all reflectors: wakes sleepers whose camera moved
+ * 
+ * Each distinct camera transform is read once per tick, so the cost is one
+ * comparison per sleeping reflector and no GDExtension callback per node.
+ * Sleepers also wake on a one-second heartbeat for size, visibility and
+ * budget checks.
+ */
+void PlanarReflectorCPP::on_event_scheduler_tick()
+{
+    uint64_t now = Time::get_singleton()->get_ticks_usec();
+
+    // Camera transforms seen this tick, by camera
+    LocalVector<Camera3D *> cameras;
+    LocalVector<Transform3D> camera_transforms;
+
+    for (uint32_t i = 0; i < registered_reflectors.size(); i++) {
+        PlanarReflectorCPP *reflector = registered_reflectors[i];
+        if (!reflector->process_sleeping || !reflector->is_active || !reflector->event_driven) {
+            continue;
+        }
+
+        if (now - reflector->sleep_started_usec >= EVENT_HEARTBEAT_USEC) {
+            reflector->wake_reflector();
+            continue;
+        }
+
+        Camera3D *camera = reflector->get_active_camera();
+        if (!camera) {
+            continue;
+        }
+
+        int64_t index = cameras.find(camera);
+        if (index < 0) {
+            index = cameras.size();
+            cameras.push_back(camera);
+            camera_transforms.push_back(camera->get_global_transform());
+        }
+
+        if (!camera_transforms[index].is_equal_approx(reflector->sleep_camera_transform)) {
+            reflector->wake_reflector();
+        }
+    }
+}
+
+/**
+ * @brief Hooks the scheduler to SceneTree::process_frame (once per process)
+ */
+void PlanarReflectorCPP::connect_event_scheduler()
+{
+    if (event_scheduler_connected || !is_inside_tree()) {
+        return;
+    }
+    get_tree()->connect("process_frame", callable_mp_static(&PlanarReflectorCPP::on_event_scheduler_tick));
+    event_scheduler_connected = true;
+}
+
+void PlanarReflectorCPP::disconnect_event_scheduler(SceneTree *tree)
+{
+    if (!event_scheduler_connected || !tree) {
+        return;
+    }
+    Callable tick = callable_mp_static(&PlanarReflectorCPP::on_event_scheduler_tick);
+    if (tree->is_connected("process_frame", tick)) {
+        tree->disconnect("process_frame", tick);
+    }
+    event_scheduler_connected = false;
+}
+
+bool PlanarReflectorCPP::is_process_sleeping() const { return process_sleeping; }
+
+/**
+ * @brief Adds one render of the given size to the current cost window
+ */
+void PlanarReflectorCPP::count_reflection_render(const Vector2i &size)
+{
+    cost_window_pixels += (uint64_t)size.x * (uint64_t)size.y;
+    cost_window_renders++;
+    trace_frame_rendered = true;
+}
+
+/**
+ * @brief Counts continuous renders and turns the half-second window into rates
+ */
+void PlanarReflectorCPP::accumulate_render_cost(double delta)
+{
+    if (reflect_viewport && reflect_viewport->get_update_mode() == SubViewport::UPDATE_ALWAYS) {
+        count_reflection_render(reflect_viewport->get_size());
+    }
+
+    cost_window_time += delta;
+    if (cost_window_time < 0.5) {
+        return;
+    }
+
+    rendered_megapixels_per_second = (double)cost_window_pixels / 1000000.0 / cost_window_time;
+    renders_per_second = (double)cost_window_renders / cost_window_time;
+    cost_window_pixels = 0;
+    cost_window_renders = 0;
+    cost_window_time = 0.0;
+
+    if (show_cost_overlay) {
+        update_cost_overlay();
+    }
+}
+
+/**
+ * @brief Why the reflection is not being rendered right now (empty when it is)
+ */
+String PlanarReflectorCPP::get_skip_reason() const
+{
+    if (!is_active) {
+        return "inactive";
+    }
+    if (!reflect_viewport) {
+        return rig_setup_started ? "rig pending" : "rig not allocated";
+    }
+    if (budget_evicted) {
+        return "evicted (VRAM budget)";
+    }
+    if (reflection_empty) {
+        return "empty mirror";
+    }
+    if (reflection_occluded) {
+        return "occluded";
+    }
+    if (pvs_culled) {
+        return "not in visibility set";
+    }
+    if (!is_visible_to_active_camera) {
+        return "not visible";
+    }
+    if (uses_on_demand_rendering() && !is_single_render_pending()) {
+        return static_until_changed ? "static (cached)" : "ortho scroll cache";
+    }
+    return String();
+}
+
+double PlanarReflectorCPP::get_rendered_megapixels_per_second() const { return rendered_megapixels_per_second; }
+double PlanarReflectorCPP::get_renders_per_second() const { return renders_per_second; }
+
+/**
+ * @brief Tints the reflector by cost, labels it and outlines shared render targets
+ * 
+ * Green is cheap, red is expensive: 100 MP/s or 60 renders/s map to full red.
+ * Reflectors sharing a material with another reflector get a cyan outline,
+ * since they all sample whichever render target was pushed last. The overlay
+ * nodes sit on a layer the reflection cameras don't render.
+ */
+void PlanarReflectorCPP::update_cost_overlay()
+{
+    if (!is_inside_tree()) {
+        return;
+    }
+
+    // Heatmap tint: an internal copy of our mesh drawn with a translucent colour,
+    // so the user's materials and material_overlay are never touched (or saved)
+    if (cost_overlay_material.is_null()) {
+        cost_overlay_material.instantiate();
+        cost_overlay_material->set_shading_mode(BaseMaterial3D::SHADING_MODE_UNSHADED);
+        cost_overlay_material->set_transparency(BaseMaterial3D::TRANSPARENCY_ALPHA);
+        cost_overlay_material->set_render_priority(1);  // Over the reflection surface
+    }
+    if (!cost_overlay_tint) {
+        cost_overlay_tint = memnew(MeshInstance3D);
+        cost_overlay_tint->set_cast_shadows_setting(GeometryInstance3D::SHADOW_CASTING_SETTING_OFF);
+        cost_overlay_tint->set_material_override(cost_overlay_material);
+        add_child(cost_overlay_tint, false, INTERNAL_MODE_BACK);  // Never saved with the scene
+    }
+    if (cost_overlay_tint->get_mesh() != get_mesh()) {
+        cost_overlay_tint->set_mesh(get_mesh());
+    }
+    uint32_t overlay_layer = get_cost_overlay_layer_bit();
+    cost_overlay_tint->set_layer_mask(overlay_layer);
+
+    double heat = cost_overlay_metric == 0 ? rendered_megapixels_per_second / 100.0 : renders_per_second / 60.0;
+    heat = Math::clamp(heat, 0.0, 1.0);
+    cost_overlay_material->set_albedo(Color(heat, 1.0 - heat, 0.0, 0.35));
+
+    // Resolution, LOD factor, rates and skip reason above the reflector
+    if (!cost_overlay_label) {
+        cost_overlay_label = memnew(Label3D);
+        cost_overlay_label->set_billboard_mode(BaseMaterial3D::BILLBOARD_ENABLED);
+        cost_overlay_label->set_draw_flag(Label3D::FLAG_DISABLE_DEPTH_TEST, true);
+        cost_overlay_label->set_pixel_size(0.005);
+        add_child(cost_overlay_label, false, INTERNAL_MODE_BACK);  // Never saved with the scene
+    }
+    cost_overlay_label->set_layer_mask(overlay_layer);
+
+    Vector2i size = reflect_viewport ? reflect_viewport->get_size() : Vector2i();
+    String skip_reason = get_skip_reason();
+    String text = itos(size.x) + "x" + itos(size.y) + "  LOD " + String::num(use_lod ? cached_lod_factor : 1.0, 2) +
+            "\n" + String::num(rendered_megapixels_per_second, 1) + " MP/s  " + String::num(renders_per_second, 1) + " renders/s";
+    if (!skip_reason.is_empty()) {
+        text += "\nskipped: " + skip_reason;
+    }
+    cost_overlay_label->set_text(text);
+    cost_overlay_label->set_position(get_aabb().get_center() + Vector3(0.0, get_aabb().size.y * 0.5 + 0.5, 0.0));
+
+    // Outline reflectors that share a render target through a shared material
+    if (shares_reflection_material()) {
+        if (!cost_overlay_outline) {
+            cost_overlay_outline = memnew(MeshInstance3D);
+            cost_overlay_outline->set_cast_shadows_setting(GeometryInstance3D::SHADOW_CASTING_SETTING_OFF);
+            add_child(cost_overlay_outline, false, INTERNAL_MODE_BACK);
+        }
+        cost_overlay_outline->set_layer_mask(overlay_layer);
+
+        if (cost_overlay_line_material.is_null()) {
+            cost_overlay_line_material.instantiate();
+            cost_overlay_line_material->set_shading_mode(BaseMaterial3D::SHADING_MODE_UNSHADED);
+            cost_overlay_line_material->set_albedo(Color(0.0, 1.0, 1.0));
+            cost_overlay_line_material->set_flag(BaseMaterial3D::FLAG_DISABLE_DEPTH_TEST, true);
+        }
+        if (cost_overlay_outline_mesh.is_null()) {
+            cost_overlay_outline_mesh.instantiate();
+            cost_overlay_outline_bounds = AABB();
+        }
+        if (cost_overlay_outline->get_mesh() != cost_overlay_outline_mesh) {
+            cost_overlay_outline->set_mesh(cost_overlay_outline_mesh);
+        }
+
+        // Outline of the local bounds, lifted slightly off the surface - rebuilt only when they change
+        AABB bounds = get_aabb().grow(0.02);
+        if (cost_overlay_outline_mesh->get_surface_count() == 0 || !bounds.is_equal_approx(cost_overlay_outline_bounds)) {
+            cost_overlay_outline_bounds = bounds;
+            cost_overlay_outline_mesh->clear_surfaces();
+            cost_overlay_outline_mesh->surface_begin(Mesh::PRIMITIVE_LINES, cost_overlay_line_material);
+            static const int edges[12][2] = { { 0, 1 }, { 1, 3 }, { 3, 2 }, { 2, 0 }, { 4, 5 }, { 5, 7 },
+                { 7, 6 }, { 6, 4 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 } };
+            for (int i = 0; i < 12; i++) {
+                cost_overlay_outline_mesh->surface_add_vertex(bounds.get_endpoint(edges[i][0]));
+                cost_overlay_outline_mesh->surface_add_vertex(bounds.get_endpoint(edges[i][1]));
+            }
+            cost_overlay_outline_mesh->surface_end();
+        }
+    } else if (cost_overlay_outline) {
+        cost_overlay_outline->queue_free();
+        cost_overlay_outline = nullptr;
+    }
+}
+
+/**
+ * @brief Whether another reflector uses one of this reflector's ShaderMaterials
+ */
+bool PlanarReflectorCPP::shares_reflection_material() const
+{
+    for (int i = 0; i < get_surface_override_material_count(); i++) {
+        Ref<Material> material = get_active_material(i);
+        if (Object::cast_to<ShaderMaterial>(material.ptr()) == nullptr) {
+            continue;
+        }
+        for (uint32_t r = 0; r < registered_reflectors.size(); r++) {
+            PlanarReflectorCPP *other = registered_reflectors[r];
+            if (other == this) {
+                continue;
+            }
+            for (int j = 0; j < other->get_surface_override_material_count(); j++) {
+                if (other->get_active_material(j) == material) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Highest render layer the reflection cameras skip, so the overlay is never reflected
+ * 
+ * Split-screen player layers are skipped too, since each player camera
+ * hides the others' layers.
+ */
+uint32_t PlanarReflectorCPP::get_cost_overlay_layer_bit() const
+{
+    uint32_t reserved = (uint32_t)reflection_layers;
+    if (split_screen_layers_applied) {
+        for (int view = 0; view <= MAX_SPLIT_SCREEN_VIEWS; view++) {
+            reserved |= get_split_screen_layer_bit(view);
+        }
+    }
+    for (int layer = 19; layer >= 0; layer--) {
+        if (!(reserved & (1u << layer))) {
+            return 1u << layer;
+        }
+    }
+    return 1u << 19;  // Every layer is reflected - the overlay shows up in reflections too
+}
+
+/**
+ * @brief Removes the overlay nodes
+ */
+void PlanarReflectorCPP::remove_cost_overlay()
+{
+    if (cost_overlay_tint) {
+        cost_overlay_tint->queue_free();
+        cost_overlay_tint = nullptr;
+    }
+    if (cost_overlay_label) {
+        cost_overlay_label->queue_free();
+        cost_overlay_label = nullptr;
+    }
+    if (cost_overlay_outline) {
+        cost_overlay_outline->queue_free();
+        cost_overlay_outline = nullptr;
+    }
+    cost_overlay_outline_mesh.unref();
+}
+
+/**
+ * @brief Toggles the cost overlay on every reflector in the process
+ */
+void PlanarReflectorCPP::set_cost_overlay_for_all(bool p_enable)
+{
+    for (uint32_t i = 0; i < registered_reflectors.size(); i++) {
+        registered_reflectors[i]->set_show_cost_overlay(p_enable);
+    }
+}
+
+/**
+ * @brief Starts writing a binary trace (ReflectionTrace.h) of every processed frame
+ * 
+ * The header stores the current scheduling and LOD settings so the replay
+ * tool can compare them against alternatives. Any running capture is closed.
+ * 
+ * @param p_path Destination file, e.g. "user://reflection_trace.prtr"
+ * @return bool True if the file was opened
+ */
+bool PlanarReflectorCPP::start_trace_capture(const String &p_path)
+{
+    stop_trace_capture();
+
+    trace_file = FileAccess::open(p_path, FileAccess::WRITE);
+    if (trace_file.is_null()) {
+        UtilityFunctions::push_error("[PlanarReflectorCPP] start_trace_capture: cannot open ", p_path);
+        return false;
+    }
+
+    ReflectionTraceHeader header = {};
+    memcpy(header.magic, REFLECTION_TRACE_MAGIC, 4);
+    header.version = REFLECTION_TRACE_VERSION;
+    header.record_size = sizeof(ReflectionTraceRecord);
+    header.update_frequency = update_frequency;
+    header.use_lod = use_lod ? 1 : 0;
+    header.min_size = get_min_reflection_size();
+    header.lod_distance_near = (float)lod_distance_near;
+    header.lod_distance_far = (float)lod_distance_far;
+    header.lod_resolution_multiplier = (float)lod_resolution_multiplier;
+    header.roughness_min_resolution_scale = (float)roughness_min_resolution_scale;
+    header.reflector_id = get_instance_id();
+
+    PackedByteArray bytes;
+    bytes.resize(sizeof(header));
+    memcpy(bytes.ptrw(), &header, sizeof(header));
+    trace_file->store_buffer(bytes);
+    trace_frame_rendered = false;
+    return true;
+}
+
+void PlanarReflectorCPP::stop_trace_capture()
+{
+    if (trace_file.is_valid()) {
+        trace_file->close();
+        trace_file.unref();
+    }
+}
+
+bool PlanarReflectorCPP::is_trace_capturing() const { return trace_file.is_valid(); }
+
+/**
+ * @brief Appends one ReflectionTraceRecord for the frame just processed
+ */
+void PlanarReflectorCPP::write_trace_record(double delta, uint32_t flags, uint64_t elapsed_usec)
+{
+    ReflectionTraceRecord record = {};
+    record.engine_frame = Engine::get_singleton()->get_process_frames();
+    record.reflector_frame = frame_counter;
+    record.delta = (float)delta;
+
+    Camera3D *active_cam = get_active_camera();
+    if (active_cam) {
+        Transform3D camera_transform = active_cam->get_global_transform();
+        Quaternion camera_rotation = camera_transform.basis.get_rotation_quaternion();
+        record.camera_position[0] = camera_transform.origin.x;
+        record.camera_position[1] = camera_transform.origin.y;
+        record.camera_position[2] = camera_transform.origin.z;
+        record.camera_rotation[0] = camera_rotation.x;
+        record.camera_rotation[1] = camera_rotation.y;
+        record.camera_rotation[2] = camera_rotation.z;
+        record.camera_rotation[3] = camera_rotation.w;
+    }
+
+    Vector3 reflector_origin = get_global_transform().origin;
+    Vector3 plane_normal = cached_reflection_plane.get_normal();
+    record.reflector_position[0] = reflector_origin.x;
+    record.reflector_position[1] = reflector_origin.y;
+    record.reflector_position[2] = reflector_origin.z;
+    record.reflector_normal[0] = plane_normal.x;
+    record.reflector_normal[1] = plane_normal.y;
+    record.reflector_normal[2] = plane_normal.z;
+    record.roughness = (float)get_effective_roughness();
+
+    Vector2i base_size = get_target_viewport_size();
+    record.base_width = base_size.x;
+    record.base_height = base_size.y;
+    if (reflect_viewport) {
+        record.chosen_width = reflect_viewport->get_size().x;
+        record.chosen_height = reflect_viewport->get_size().y;
+    }
+
+    if (is_visible_to_active_camera) {
+        flags |= REFLECTION_TRACE_VISIBLE;
+    }
+    if (budget_evicted) {
+        flags |= REFLECTION_TRACE_EVICTED;
+    }
+    if (reflection_empty) {
+        flags |= REFLECTION_TRACE_EMPTY;
+    }
+
+    // Renders as count_reflection_render counts them - the camera update alone draws nothing
+    if (trace_frame_rendered) {
+        flags |= REFLECTION_TRACE_RENDERED;
+        trace_frame_rendered = false;
+    }
+    if (reflect_viewport && reflect_viewport->get_update_mode() == SubViewport::UPDATE_ALWAYS) {
+        flags |= REFLECTION_TRACE_CONTINUOUS;
+    }
+    record.flags = flags;
+    record.update_usec = (uint32_t)Math::min(elapsed_usec, (uint64_t)UINT32_MAX);
+
+    PackedByteArray bytes;
+    bytes.resize(sizeof(record));
+    memcpy(bytes.ptrw(), &record, sizeof(record));
+    trace_file->store_buffer(bytes);
+}
+
+/**
+ * @brief Creates the reflection viewport and camera system
+ * 
+ * This is the core setup function that creates:
+ * 1. SubViewport for rendering reflections
+ * 2. Camera3D for capturing the reflected view
+ * 3. Proper cleanup of any existing system
+ */
+void PlanarReflectorCPP::setup_reflection_camera_and_viewport()
+{
+    // CRITICAL: Clear shader texture references before destroying viewport
+    // This prevents crashes from dangling texture pointers in materials
+    clear_shader_texture_references();
+    
+    // Safe cleanup of existing reflection viewport
+    if (reflect_viewport) {
+        if (reflect_viewport->is_inside_tree()) {
+            reflect_viewport->get_parent()->remove_child(reflect_viewport);
+        }
+        reflect_viewport->queue_free();  // Godot's safe deletion method
+        reflect_viewport = nullptr;
+    }
+    
+    // Camera will be freed automatically when viewport is destroyed
+    if (reflect_camera) {
+        reflect_camera = nullptr;
+    }
+
+    // PERFORMANCE: Wait one frame before creating new viewport
+    // This prevents rapid create/destroy cycles during initialization
+    if (frame_counter > 0) {
+        call_deferred("create_viewport_deferred");
+        return;
+    }
+    
+    // First frame - create immediately
+    create_viewport_deferred();
+}
+
+/**
+ * @brief Deferred viewport creation - Ensures safe initialization
+ */
+void PlanarReflectorCPP::create_viewport_deferred()
+{
+    // Create SubViewport with unique name to avoid conflicts
+    reflect_viewport = create_reflection_subviewport("ReflectionViewPort", reflect_camera);
+    
+    // Check if layer 1 is active (important for lighting)
+    is_layer_one_active = bool(reflection_layers & (1 << 0));
+    
+    // Setup environment and compositor effects
+    setup_reflection_environment();
+    
+    // Setup compositor effects for advanced reflection features
+    if (reflect_camera) {
+        call_deferred("setup_compositor_reflection_effect", reflect_camera);
+    }
+}
+
+/**
+ * @brief Creates one reflection SubViewport with its camera as a child of this node
+ * 
+ * Shared by the primary rig and the split-screen views so every reflection
+ * target is configured identically.
+ * 
+ * @param viewport_name Node name of the new SubViewport
+ * @param r_camera Receives the reflection camera created inside the viewport
+ * @return SubViewport* The configured viewport
+ */
+SubViewport *PlanarReflectorCPP::create_reflection_subviewport(const String &viewport_name, Camera3D *&r_camera)
+{
+    SubViewport *viewport = memnew(SubViewport);
+    viewport->set_name(viewport_name);
+    
+    // Add as child - this viewport will render our reflection
+    add_child(viewport);
+    
+    // Configure viewport for reflection rendering
+    viewport->set_size(reflection_camera_resolution);           // Set target resolution
+    viewport->set_update_mode(SubViewport::UPDATE_ALWAYS);      // Continuous updates
+    viewport->set_msaa_3d(Viewport::MSAA_DISABLED);             // MSAA off for performance
+    viewport->set_positional_shadow_atlas_size(REFLECTION_SHADOW_ATLAS_SIZE); // Decent shadow quality
+    viewport->set_use_own_world_3d(false);                      // Share world with main scene
+    viewport->set_transparent_background(true);                 // Allow alpha blending
+    viewport->set_handle_input_locally(false);                  // No input needed
+
+    // Create the reflection camera
+    Camera3D *camera = memnew(Camera3D);
+    camera->set_name("ReflectCamera");
+    viewport->add_child(camera);
+    
+    // Configure camera layer visibility
+    camera->set_cull_mask(reflection_layers);
+    
+    // Copy properties from main camera if available
+    if (main_camera) {
+        camera->set_attributes(main_camera->get_attributes());      // Copy camera attributes
+        camera->set_doppler_tracking(main_camera->get_doppler_tracking());  // Copy audio settings
+    }
+    
+    // Make this camera active for its viewport
+    camera->set_current(true);
+
+    r_camera = camera;
+    return viewport;
+}
+
+/**
+ * @brief Configures the reflection camera's rendering environment
+ * 
+ * Sets up the Environment resource that controls:
+ * - Background rendering (clear color vs skybox)
+ * - Ambient lighting settings
+ * - Fog and atmospheric effects
+ */
+void PlanarReflectorCPP::setup_reflection_environment()
+{
+    if (!reflect_camera) {
+        return;
+    }
+
+    // Apply environment to reflection camera
+    // Use custom environment if specified
+    if (use_custom_environment && custom_environment.is_valid()) {
+        reflect_camera->set_environment(custom_environment);
+        // UtilityFunctions::print("[PlanarReflectorCPP] Camera Reflection -> set using Custom Editor Environment");
+    } else if (derive_environment_from_camera && refresh_derived_environment()) {
+        // Lightweight copy of the main camera / world environment is now active
+    } else {
+        // Create default environment optimized for reflections
+        Ref<Environment> reflection_env;
+        reflection_env.instantiate();
+        reflection_env->set_background(Environment::BG_CLEAR_COLOR);        // Clear background
+        reflection_env->set_ambient_source(Environment::AMBIENT_SOURCE_COLOR);  // Use ambient color
+        reflection_env->set_ambient_light_color(Color(0.8, 0.8, 0.8));     // Neutral gray
+        reflection_env->set_ambient_light_energy(1.0);     
+        
+        reflect_camera->set_environment(reflection_env);// Standard intensity
+        // UtilityFunctions::print("[PlanarReflectorCPP] Camera Reflection -> set using Default Environment");
+    }
+}
+
+// Diagnostics - thin static wrappers so scripts reach ReflectionDiagnostics through this class
+Dictionary PlanarReflectorCPP::get_diagnostic_counts() { return ReflectionDiagnostics::get_counts(); }
+Array PlanarReflectorCPP::get_recent_diagnostics(int p_max_events) { return ReflectionDiagnostics::get_recent(p_max_events); }
+void PlanarReflectorCPP::clear_diagnostics() { ReflectionDiagnostics::clear(); }
+void PlanarReflectorCPP::set_diagnostics_print_enabled(bool p_enabled) { ReflectionDiagnostics::set_print_enabled(p_enabled); }
+bool PlanarReflectorCPP::get_diagnostics_print_enabled() { return ReflectionDiagnostics::is_print_enabled(); }
+void PlanarReflectorCPP::set_diagnostics_print_interval(double p_seconds) { ReflectionDiagnostics::set_print_interval(p_seconds); }
+double PlanarReflectorCPP::get_diagnostics_print_interval() { return ReflectionDiagnostics::get_print_interval(); }
+
+/**
+ * @brief Starts a property batch - setters record what needs redoing instead of doing it
+ * 
+ * Batches nest; the work runs when the outermost commit_batch() is reached.
+ */
+void PlanarReflectorCPP::begin_batch()
+{
+    batch_depth++;
+}
+
+/**
+ * @brief Ends a property batch and runs the deferred work once
+ */
+void PlanarReflectorCPP::commit_batch()
+{
+    if (batch_depth == 0) {
+        UtilityFunctions::push_warning("[PlanarReflectorCPP] commit_batch called without begin_batch");
+        return;
+    }
+
+    batch_depth--;
+    if (batch_depth == 0) {
+        flush_batch();
+    }
+}
+
+bool PlanarReflectorCPP::is_batching() const { return batch_depth > 0; }
+
+/**
+ * @brief Sets several properties (name -> value) as one batch
+ * 
+ * Keys are property names as shown in the inspector, e.g.
+ * { "hide_intersect_reflections": false, "reflection_camera_resolution": Vector2i(960, 540) }.
+ */
+void PlanarReflectorCPP::apply_settings(const Dictionary &p_settings)
+{
+    begin_batch();
+
+    Array keys = p_settings.keys();
+    for (int64_t i = 0; i < keys.size(); i++) {
+        set(keys[i], p_settings[keys[i]]);
+    }
+
+    commit_batch();
+}
+
+/**
+ * @brief Records deferred work while batching
+ * 
+ * @param p_flags BatchDirtyFlags describing the work the caller would do
+ * @return bool True if a batch is open and the caller must skip the work
+ */
+bool PlanarReflectorCPP::defer_to_batch(uint32_t p_flags)
+{
+    if (batch_depth == 0) {
+        return false;
+    }
+    batch_dirty |= p_flags;
+    return true;
+}
+
+/**
+ * @brief Runs the work recorded during the batch, each kind once
+ */
+void PlanarReflectorCPP::flush_batch()
+{
+    uint32_t dirty = batch_dirty;
+    batch_dirty = 0;
+
+    if (dirty == 0 || !is_inside_tree()) {
+        return;
+    }
+
+    if (reflect_camera) {
+        if (dirty & BATCH_DIRTY_ENVIRONMENT) {
+            setup_reflection_environment();
+        }
+        if (dirty & BATCH_DIRTY_COMPOSITOR) {
+            setup_compositor_reflection_effect(reflect_camera);  // Also refreshes the parameters
+        } else if (dirty & BATCH_DIRTY_COMPOSITOR_PARAMS) {
+            update_compositor_parameters();
+        }
+    }
+
+    if ((dirty & BATCH_DIRTY_RESIZE) && reflect_viewport) {
+        reflect_viewport->set_size(reflection_camera_resolution);
+        last_viewport_check_frame = frame_counter - viewport_check_frequency;  // LOD pass on the next frame
+    }
+
+    // One shader update for everything that changed
+    invalidate_reflection_cache();
+    update_shader_parameters();
+}
+
+/**
+ * @brief Environment the reflection should look like - main camera first, then the world
+ */
+Ref<Environment> PlanarReflectorCPP::get_source_environment()
+{
+    Camera3D *active_cam = get_active_camera();
+    if (active_cam && active_cam->get_environment().is_valid()) {
+        return active_cam->get_environment();
+    }
+
+    Ref<World3D> world = get_world_3d();
+    if (world.is_null()) {
+        return Ref<Environment>();
+    }
+    if (world->get_environment().is_valid()) {
+        return world->get_environment();  // WorldEnvironment node
+    }
+    return world->get_fallback_environment();
+}
+
+/**
+ * @brief Assigns the derived environment for the current source and tier, building it if needed
+ * 
+ * Derived environments are cached process-wide by source environment and
+ * tier, so all reflectors looking at the same world share one instance. An
+ * entry is rebuilt only when the source's fingerprint changes, and entries
+ * of freed sources are pruned whenever a new one is built.
+ * 
+ * @return bool True if a derived environment is assigned to the reflection camera
+ */
+bool PlanarReflectorCPP::refresh_derived_environment()
+{
+    if (!reflect_camera) {
+        return false;
+    }
+
+    Ref<Environment> source = get_source_environment();
+    if (source.is_null()) {
+        return false;  // Caller falls back to the default environment
+    }
+
+    DerivedEnvironmentKey key;
+    key.source_id = source->get_instance_id();
+    key.tier = reflection_environment_tier;
+    uint32_t fingerprint = compute_environment_fingerprint(source);
+
+    DerivedEnvironment *entry = derived_environment_cache.getptr(key);
+    if (!entry || entry->fingerprint != fingerprint || entry->environment.is_null()) {
+        // Shallow copy - the Sky resource and its material stay shared with the source
+        Ref<Environment> derived = source->duplicate(false);
+        if (derived.is_null()) {
+            return false;
+        }
+        strip_environment_for_tier(derived, reflection_environment_tier);
+
+        if (!entry) {
+            prune_derived_environments();  // Growing - drop what freed sources left behind
+        }
+
+        DerivedEnvironment rebuilt;
+        rebuilt.environment = derived;
+        rebuilt.fingerprint = fingerprint;
+        derived_environment_cache.insert(key, rebuilt);
+        entry = derived_environment_cache.getptr(key);
+    }
+
+    if (reflect_camera->get_environment() != entry->environment) {
+        reflect_camera->set_environment(entry->environment);
+        invalidate_reflection_cache();
+    }
+    return true;
+}
+
+/**
+ * @brief Drops derived environments whose source Environment has been freed
+ */
+void PlanarReflectorCPP::prune_derived_environments()
+{
+    LocalVector<DerivedEnvironmentKey> stale;
+    for (const KeyValue<DerivedEnvironmentKey, DerivedEnvironment> &entry : derived_environment_cache) {
+        if (!ObjectDB::get_instance(entry.key.source_id)) {
+            stale.push_back(entry.key);
+        }
+    }
+    for (uint32_t i = 0; i < stale.size(); i++) {
+        derived_environment_cache.erase(stale[i]);
+    }
+}
+
+/**
+ * @brief Frees every derived environment (last reflector gone, or extension unload)
+ */
+void PlanarReflectorCPP::release_derived_environments()
+{
+    derived_environment_cache.clear();
+}
+
+/**
+ * @brief Hash of the source settings a derived environment copies (sky, ambient, tonemap, fog)
+ */
+uint32_t PlanarReflectorCPP::compute_environment_fingerprint(const Ref<Environment> &source)
+{
+    Array values;
+    values.push_back(source->get_background());
+    values.push_back(source->get_sky().is_valid() ? (int64_t)source->get_sky()->get_instance_id() : (int64_t)0);
+    values.push_back(source->get_sky_rotation());
+    values.push_back(source->get_bg_color());
+    values.push_back(source->get_bg_energy_multiplier());
+    values.push_back(source->get_ambient_source());
+    values.push_back(source->get_ambient_light_color());
+    values.push_back(source->get_ambient_light_energy());
+    values.push_back(source->get_ambient_light_sky_contribution());
+    values.push_back(source->get_reflection_source());
+    values.push_back(source->get_tonemapper());
+    values.push_back(source->get_tonemap_exposure());
+    values.push_back(source->get_tonemap_white());
+    values.push_back(source->is_fog_enabled());
+    values.push_back(source->get_fog_light_color());
+    values.push_back(source->get_fog_density());
+    values.push_back(source->get_fog_sky_affect());
+    values.push_back(source->get_fog_height());
+    values.push_back(source->get_fog_height_density());
+    values.push_back(source->is_glow_enabled());
+    values.push_back(source->is_volumetric_fog_enabled());
+    return values.hash();
+}
+
+/**
+ * @brief Turns off the features a reflection cannot afford at the given tier
+ * 
+ * SSR, SSIL and SDFGI are always stripped: screen-space effects see only the
+ * reflection's own small view, and GI is already baked into what is reflected.
+ * Medium also drops SSAO and volumetric fog; Low drops glow as well.
+ */
+void PlanarReflectorCPP::strip_environment_for_tier(const Ref<Environment> &environment, int tier)
+{
+    environment->set_ssr_enabled(false);
+    environment->set_ssil_enabled(false);
+    environment->set_sdfgi_enabled(false);
+
+    if (tier <= 1) {
+        environment->set_ssao_enabled(false);
+        environment->set_volumetric_fog_enabled(false);
+    }
+    if (tier <= 0) {
+        environment->set_glow_enabled(false);
+    }
+}
+
+/**
+ * @brief Locates the editor helper singleton for viewport size detection (required for Editor Cam and ViewPortSync)
+ * 
+ * In editor mode, we need to detect the size of the 3D viewport
+ * window to match reflection resolution to the editor view.
+ * This function finds the PlanarReflectorEditorHelper singleton
+ * that provides this functionality.
+ */
+void PlanarReflectorCPP::find_editor_helper()
+{
+    if (Engine::get_singleton()->is_editor_hint()) {
+        // Check if the editor helper singleton is registered
+        if (Engine::get_singleton()->has_singleton("PlanarReflectorEditorHelper")) {
+            editor_helper = Engine::get_singleton()->get_singleton("PlanarReflectorEditorHelper");
+        }
+    }
+}
+
+/**
+ * @brief Sets up compositor effects for advanced reflection features
+ * 
+ * The Compositor system in Godot 4.4+ allows post-processing effects
+ * to be applied to camera rendering. For reflections, we use it to:
+ * - Hide geometry that intersects the reflection plane
+ * - Fill gaps in reflections (experimental feature)
+ * - Adjust reflection appearance at the pixel level
+ * @param reflect_cam The reflection camera to apply effects to
+ */
+void PlanarReflectorCPP::setup_compositor_reflection_effect(Camera3D *reflect_cam) 
+{
+    if (!reflect_cam) {
+        return;
+    }
+    
+    // Priority 1: Use explicitly set compositor
+    if(active_compositor.is_valid() && (reflect_cam->get_compositor() != active_compositor))
+    {
+        reflect_cam->set_compositor(active_compositor);
+        update_compositor_parameters();  // Configure effect parameters
+        return;
+    }
+
+    // Priority 2: Create new compositor if camera doesn't have one
+    Ref<Compositor> current_comp = reflect_cam->get_compositor();
+    if (!current_comp.is_valid() || current_comp->get_compositor_effects().size() == 0) {
+        // Load compositor from resource file and assign to camera
+        active_compositor = create_new_compositor();
+        reflect_cam->set_compositor(active_compositor);
+        update_compositor_parameters();
+        return;
+    }
+}
+
+/**
+ * @brief Creates a new compositor by loading from resource file
+ * Loads the reflection compositor effect from a .tres resource file
+ * that contains pre-configured CompositorEffect settings. The resource
+ * is duplicated to ensure each reflection camera gets its own instance.
+ * 
+ * @return Ref<Compositor> New compositor instance, or empty ref if loading fails
+ */
+Ref<Compositor> PlanarReflectorCPP::create_new_compositor() 
+{
+    // Load the pre-configured reflection compositor resource
+    Variant loaded_resource = ResourceLoader::get_singleton()->load("res://addons/PlanarReflectorCpp/SupportFiles/reflection_compositor.tres");
+    
+    if (loaded_resource.get_type() == Variant::OBJECT) 
+    {
+        // CRITICAL: Create a unique copy using duplicate(true) for deep copy
+        // This ensures each camera gets its own effect instance
+        Ref<Resource> resource_ref = loaded_resource;
+        if (resource_ref.is_valid()) 
+        {
+            Ref<Resource> unique_copy = resource_ref->duplicate(true); // Deep copy
+            Ref<Compositor> compositor = Object::cast_to<Compositor>(unique_copy.ptr());
+            return compositor;
+        }
+    } 
+
+    // Return empty compositor if loading fails
+    return Ref<Compositor>();
+}
+
+/**
+ * @brief Updates compositor effect parameters with current reflection settings
+ * 
+ * Configures the compositor effect with reflection-specific parameters:
+ * - effect_enabled: Whether the effect should be active
+ * - fill_enabled: Whether to use experimental gap filling
+ * - intersect_height: Y-coordinate of the reflection plane
+ */
+void PlanarReflectorCPP::update_compositor_parameters()
+{
+    if (!active_compositor.is_valid()) return;
+    
+    // Get the first compositor effect (our reflection effect)
     TypedArray<CompositorEffect> effects = active_compositor->get_compositor_effects();
     if (effects.size() > 0) {
         CompositorEffect* effect = Object::cast_to<CompositorEffect>(effects[0]);
@@ -432,7 +1785,8 @@ void PlanarReflectorCPP::update_compositor_parameters()
             double height = override_YAxis_height ? new_YAxis_height : get_global_transform().get_origin().y;
             
             // Update effect parameters
-            effect->set("effect_enabled", hide_intersect_reflections);
+            // Skipped while the near plane already clips everything behind the mirror
+            effect->set("effect_enabled", hide_intersect_reflections && !intersect_pass_redundant);
             effect->set("fill_enabled", fill_reflection_experimental);
             effect->set("intersect_height", height);
         }
@@ -440,209 +1794,2416 @@ void PlanarReflectorCPP::update_compositor_parameters()
 }
 
 /**
- * @brief Calculates the reflection plane based on reflector transform
+ * @brief Calculates the reflection plane based on reflector transform
+ * 
+ * The reflection plane defines the mathematical surface across which
+ * the camera view is mirrored. 
+ * 
+ * @return Plane The reflection plane in world space
+ */
+Plane PlanarReflectorCPP::calculate_reflection_plane()
+{
+    if (!is_inside_tree()) {
+        return Plane();  // Return invalid plane if not in scene
+    }
+        
+    Transform3D current_transform = get_global_transform();
+    
+    // Create reflection plane by rotating reflector transform 90 degrees around X
+    // This makes the "up" direction (Y) become the plane normal
+    Transform3D reflection_transform = current_transform * Transform3D().rotated(Vector3(1, 0, 0), Math_PI / 2.0);
+    
+    // Extract plane properties from the transformed basis
+    Vector3 plane_origin = reflection_transform.get_origin();           // Point on plane
+    Vector3 plane_normal = reflection_transform.get_basis().get_column(2).normalized();  // Plane normal
+    
+    // Create plane using normal and distance from origin
+    // Distance = normal • origin (dot product)
+    cached_reflection_plane = Plane(plane_normal, plane_origin.dot(plane_normal));
+    last_global_transform = current_transform;
+    
+    return cached_reflection_plane;
+}
+
+/**
+ * @brief Updates reflection viewport size based on screen/editor size and LOD
+ * 
+ * Manages the resolution of the reflection viewport and sets the LOD system
+ */
+void PlanarReflectorCPP::update_reflect_viewport_size()
+{
+    if (!reflect_viewport) {
+        ReflectionDiagnostics::report(REFLECTION_DIAG_NULL_VIEWPORT, get_instance_id(), "ERROR: update_reflect_viewport_size - reflect_viewport is null");
+        return;
+    }
+
+    // Evicted reflectors keep their minimal target until the budget allows more,
+    // prewarming ones their tiny target until the prewarm render is drawn
+    if (budget_evicted || prewarm_in_progress) {
+        return;
+    }
+    
+    // Performance optimization: only check size periodically
+    if (frame_counter - last_viewport_check_frame < viewport_check_frequency) {
+        return;
+    }
+    last_viewport_check_frame = frame_counter;
+    
+    // Get base target size from screen/editor
+    Vector2i target_size = get_target_viewport_size();
+    Camera3D *active_cam = get_active_camera();
+    
+    // Apply LOD scaling if enabled and we have an active camera
+    if (use_lod && active_cam) {
+        target_size = apply_lod_to_size(target_size, active_cam);
+    }
+
+    // Blurred reflections do not need full resolution
+    target_size = apply_roughness_to_size(target_size);
+
+    // Orthographic scroll cache renders the margin around the view as well
+    if (is_ortho_scroll_cache_active()) {
+        double extent_scale = get_ortho_cache_extent_scale();
+        target_size = Vector2i((double)target_size.x * extent_scale, (double)target_size.y * extent_scale);
+    }
+
+    // Interleaved phases are full size - the column mask keeps half of each unshaded
+    interleave_full_size = target_size;
+    if (is_interleaving_active() && interleave_viewport->get_size() != target_size) {
+        interleave_viewport->set_size(target_size);
+    }
+
+    // Apply the calculated size to the viewport
+    if (reflect_viewport->get_size() != target_size) {
+        reflect_viewport->set_size(target_size);
+        // Resized targets hold no valid image until rendered again
+        invalidate_reflection_cache();
+    }
+}
+
+/**
+ * @brief Main reflection calculation - Updates camera transform and shader parameters
+ * 
+ * This is the core function that creates the reflection effect by:
+ * 1. Calculating the reflection plane from the reflector's position
+ * 2. Computing the mirrored camera position across the plane
+ * 3. Creating a mirrored camera orientation (basis)
+ * 4. Applying any configured offset adjustments
+ * 5. Updating shader parameters with the new reflection data
+ */
+void PlanarReflectorCPP::set_reflection_camera_transform()
+{
+    // Validate scene tree state
+    if (!is_inside_tree()) {
+        // UtilityFunctions::print("[PlanarReflectorCPP] ERROR: set_reflection_camera_transform stopped - Not Inside Tree");
+        return;
+    }
+        
+    // Validate required cameras exist
+    Camera3D *active_camera = get_active_camera();
+    if (!active_camera || !reflect_camera) {
+        ReflectionDiagnostics::report(REFLECTION_DIAG_MISSING_CAMERA, get_instance_id(), "Info: Missing Camera or Reflect Camera not loaded. Reflections will not show.");
+        return;
+    }
+        
+    // Update camera projection settings to match main camera
+    update_camera_projection();
+    
+    // Calculate the mathematical reflection plane
+    Plane reflection_plane = calculate_reflection_plane();
+
+    // Static mode: tracked content changes or staleness invalidate the cached render
+    if (static_until_changed) {
+        bool stale = max_staleness > 0.0 && time_since_render >= max_staleness;
+        if (detect_tracked_content_changes() || stale) {
+            flush_pose_cache();  // Renders of other poses show the old content too
+            invalidate_reflection_cache();
+        }
+    }
+
+    // Orthographic pans inside the cached margin only scroll the UVs
+    if (is_ortho_scroll_cache_active() && update_ortho_scroll_cache(active_camera)) {
+        update_shader_parameters();
+        apply_viewport_update_mode();
+        return;
+    }
+    
+    // STEPS 1-5: Mirror the active camera (or its predicted pose) across the plane (plus offsets)
+    Transform3D final_reflection_transform;
+    if (is_prediction_active()) {
+        track_camera_motion(active_camera->get_global_transform());
+        final_reflection_transform = compute_reflection_transform(get_predicted_camera_transform(active_camera), reflection_plane);
+    } else {
+        final_reflection_transform = compute_reflection_transform(active_camera, reflection_plane);
+    }
+        
+    // STEP 6: Set the calculated transform on the reflection camera
+    reflect_camera->set_global_transform(final_reflection_transform);
+    rendered_reflection_transform = final_reflection_transform;
+
+    // Fit near/far to the mirror - the intersect pass is redundant when the near plane is the mirror plane
+    bool pass_redundant = fit_reflection_clip_planes(reflect_camera, final_reflection_transform, active_camera);
+    if (pass_redundant != intersect_pass_redundant) {
+        intersect_pass_redundant = pass_redundant;
+        update_compositor_parameters();
+    }
+
+    // Second phase camera shares the view
+    if (is_interleaving_active()) {
+        update_interleave_camera(active_camera);
+    }
+
+    // Re-anchor the scroll cache around the new view and render it once
+    if (is_ortho_scroll_cache_active()) {
+        anchor_ortho_scroll_cache(active_camera);
+    }
+
+    // Static mode: a moved mirror view needs a new render as well - unless that pose is cached
+    if (static_until_changed && !final_reflection_transform.is_equal_approx(last_rendered_reflection_transform)) {
+        if (!use_cached_pose(final_reflection_transform)) {
+            request_reflection_render();
+        }
+    }
+
+    // Nothing on reflection_layers in the mirrored frustum - skip the scene pass
+    update_empty_reflection_state();
+    
+    // STEP 7: Update shader material with new reflection data
+    update_shader_parameters();
+    apply_viewport_update_mode();
+}
+
+/**
+ * @brief Mirrors a camera transform across the reflection plane
+ * 
+ * @param source_cam The camera whose view is reflected
+ * @param reflection_plane The plane to mirror across
+ * @return Transform3D The reflection camera transform, offsets applied
+ */
+Transform3D PlanarReflectorCPP::compute_reflection_transform(Camera3D *source_cam, const Plane &reflection_plane)
+{
+    return compute_reflection_transform(source_cam->get_global_transform(), reflection_plane);
+}
+
+/**
+ * @brief Mirrors a camera pose across the reflection plane (plus offsets)
+ */
+Transform3D PlanarReflectorCPP::compute_reflection_transform(const Transform3D &source_transform, const Plane &reflection_plane)
+{
+    // STEP 1: Calculate mirrored camera position
+    Vector3 cam_pos = source_transform.get_origin();
+    Vector3 proj_pos = reflection_plane.project(cam_pos);           // Project onto plane
+    Vector3 mirrored_pos = cam_pos + (proj_pos - cam_pos) * 2.0;    // Mirror across plane
+    
+    // STEP 2: Create base transform with mirrored position
+    Transform3D base_reflection_transform;
+    base_reflection_transform.set_origin(mirrored_pos);
+    
+    // STEP 3: Calculate mirrored camera orientation (basis)
+    Basis main_basis = source_transform.get_basis();
+    Vector3 n = reflection_plane.get_normal();
+    
+    // Mirror each basis vector by bouncing it off the plane normal
+    // bounce() function: vector - 2 * (vector • normal) * normal
+    Basis reflection_basis;
+    reflection_basis.set_column(0, main_basis.get_column(0).normalized().bounce(n).normalized());  // Right vector
+    reflection_basis.set_column(1, main_basis.get_column(1).normalized().bounce(n).normalized());  // Up vector
+    reflection_basis.set_column(2, main_basis.get_column(2).normalized().bounce(n).normalized());  // Forward vector
+    
+    // STEP 4: Combine position and orientation and create base transform
+    base_reflection_transform.set_basis(reflection_basis);
+    
+    // STEP 5: Apply any configured offset adjustments
+    if(enable_reflection_offset) 
+    {
+        return apply_reflection_offset(base_reflection_transform);
+    }
+    return base_reflection_transform;
+}
+
+/**
+ * @brief Fits the reflection camera's near and far planes to the mirror
+ * 
+ * Godot 4.4 cameras cannot use an oblique near plane, so the near plane is
+ * placed at the closest point of the reflector bounds in view depth. Every
+ * visible reflected ray hits the mirror at or beyond that depth, so nothing
+ * in front of the near plane can appear in the reflection - it is all behind
+ * the mirror. When the view axis is (nearly) perpendicular to the mirror the
+ * near plane coincides with the mirror plane and the compositor intersect
+ * pass has nothing left to hide.
+ * 
+ * @param target_cam Reflection camera to set near/far on
+ * @param reflection_transform Mirrored pose the camera renders from (the predicted one when extrapolating)
+ * @param source_cam Camera being mirrored (far plane source)
+ * @return bool True if the near plane alone clips the reflection correctly
+ */
+bool PlanarReflectorCPP::fit_reflection_clip_planes(Camera3D *target_cam, const Transform3D &reflection_transform, Camera3D *source_cam)
+{
+    // Offsets move the camera off the true mirror position - depth no longer maps to the plane
+    if (!tight_reflection_clip || enable_reflection_offset) {
+        return false;
+    }
+
+    Transform3D view_inverse = reflection_transform.affine_inverse();
+    Transform3D reflector_transform = get_global_transform();
+    AABB local_bounds = get_aabb();
+
+    // Closest reflector corner along the view axis (-Z)
+    double min_depth = 1e20;
+    for (int i = 0; i < 8; i++) {
+        Vector3 corner = view_inverse.xform(reflector_transform.xform(local_bounds.get_endpoint(i)));
+        min_depth = Math::min(min_depth, (double)-corner.z);
+    }
+
+    // Small margin so the mirror surface itself is never clipped
+    double near_plane = Math::max(min_depth - 0.01, 0.05);
+    double far_plane = source_cam->get_far();
+    if (reflection_draw_distance > 0.0) {
+        far_plane = Math::min(far_plane, near_plane + reflection_draw_distance);
+    }
+    far_plane = Math::max(far_plane, near_plane + 0.1);
+
+    if (!Math::is_equal_approx(target_cam->get_near(), near_plane)) {
+        target_cam->set_near(near_plane);
+    }
+    if (!Math::is_equal_approx(target_cam->get_far(), far_plane)) {
+        target_cam->set_far(far_plane);
+    }
+
+    // Near plane parallel to the mirror only when looking straight at it
+    Vector3 view_axis = -reflection_transform.basis.get_column(2).normalized();
+    bool aligned = Math::abs(view_axis.dot(cached_reflection_plane.get_normal())) >= 0.9995;
+    return aligned && min_depth > 0.05 && !fill_reflection_experimental;
+}
+
+/**
+ * @brief Updates shader material parameters with current reflection data
+ * 
+ * Transfers reflection rendering data to the shader material that
+ * displays the reflection effect.
+ */
+void PlanarReflectorCPP::update_shader_parameters()
+{
+    // Validate that we have surface materials to work with (every ShaderMaterial surface is updated)
+    LocalVector<ShaderMaterial *> materials;
+    if (!gather_reflection_materials(materials) || !reflect_viewport) {
+        // UtilityFunctions::print("[PlanarReflectorCPP] Info: Please add a material and reload the scene to enable reflection.");
+        return;
+    }
+
+    // Pick up the blur amount the shader applies so resolution can follow it
+    if (auto_detect_roughness) {
+        detect_material_roughness(materials[0]);
+    }
+
+    // Get the rendered reflection texture from viewport
+    SubViewport *sampled_viewport = get_sampled_viewport();
+    Ref<Texture2D> reflection_texture = sampled_viewport->get_texture();
+    bool is_orthogonal = false;
+    
+    // Determine camera projection type for shader math
+    Camera3D *active_cam = get_active_camera();
+    if (active_cam) {
+        is_orthogonal = (active_cam->get_projection() == Camera3D::PROJECTION_ORTHOGONAL);
+    }
+    
+    // Validate reflection texture quality
+    if(reflection_texture.is_null() || reflection_texture.is_valid() == false || 
+       reflection_texture->get_size() != sampled_viewport->get_size())
+    {
+        ReflectionDiagnostics::report(REFLECTION_DIAG_INVALID_TEXTURE, get_instance_id(), "ERROR: update_shader_parameters - No valid texture found");
+    }
+    
+    // Update all shader parameters for reflection rendering
+    set_reflection_parameter(materials, "reflection_screen_texture", reflection_texture);      // Main reflection image
+    set_reflection_parameter(materials, "is_orthogonal_camera", is_orthogonal);              // Projection type flag
+    set_reflection_parameter(materials, "ortho_uv_scale", ortho_uv_scale);                   // UV scaling for ortho
+    set_reflection_parameter(materials, "ortho_scroll_offset", ortho_scroll_offset);         // Pan inside the cached render
+    set_reflection_parameter(materials, "ortho_cache_scale", 1.0 / get_ortho_cache_extent_scale()); // Visible fraction of the cached render
+    set_reflection_parameter(materials, "reflection_offset_enabled", enable_reflection_offset); // Offset system flag
+    set_reflection_parameter(materials, "reflection_offset_position", reflection_offset_position); // Position offset
+    set_reflection_parameter(materials, "reflection_offset_scale", reflection_offset_scale);  // Scale offset
+    set_reflection_parameter(materials, "reflection_plane_normal", cached_reflection_plane.get_normal()); // Plane normal vector
+    set_reflection_parameter(materials, "reflection_plane_distance", cached_reflection_plane.d);      // Plane distance
+    set_reflection_parameter(materials, "planar_surface_y", get_global_transform().get_origin().y);  // Surface height
+    set_reflection_parameter(materials, "reflection_environment_only", is_environment_only()); // No rendered reflection available
+    set_reflection_parameter(materials, "reflection_overscan", is_prediction_active() ? prediction_overscan : 0.0); // Extra margin around the predicted view
+
+    // Mirrored pose the sampled texture was rendered from - the front buffer lags the back camera by one render
+    Transform3D render_transform = is_double_buffering_active() ? front_buffer_camera->get_global_transform() : rendered_reflection_transform;
+    set_reflection_parameter(materials, "reflection_render_transform", render_transform);
+
+    // Per-camera textures for split-screen
+    push_split_screen_shader_parameters(materials);
+
+    // Second phase texture and reconstruction data for interleaved rendering
+    push_interleave_shader_parameters(materials);
+}
+
+/**
+ * @brief Collects the distinct ShaderMaterials on all of the mesh's surfaces
+ * 
+ * The list holds raw pointers, so callers keep it local to the push it
+ * was gathered for and pass it on to set_reflection_parameter().
+ * 
+ * @param r_materials Receives the materials
+ * @return bool True if at least one surface has a ShaderMaterial
+ */
+bool PlanarReflectorCPP::gather_reflection_materials(LocalVector<ShaderMaterial *> &r_materials) const
+{
+    r_materials.clear();
+
+    int surface_count = get_surface_override_material_count();
+    for (int i = 0; i < surface_count; i++) {
+        ShaderMaterial *material = Object::cast_to<ShaderMaterial>(get_active_material(i).ptr());
+        if (material && r_materials.find(material) < 0) {
+            r_materials.push_back(material);
+        }
+    }
+    return !r_materials.is_empty();
+}
+
+/**
+ * @brief Writes one piece of reflection state where the shader reads it
+ * 
+ * With use_instance_uniforms, plain values become per-instance uniforms, so
+ * reflectors can share one material. Godot has no instance sampler
+ * uniforms, so textures (and arrays of them) always go to the materials.
+ * Sharers of one material therefore all sample the texture pushed last,
+ * which suits reflectors that show the same reflection (e.g. coplanar tiles).
+ */
+void PlanarReflectorCPP::set_reflection_parameter(const LocalVector<ShaderMaterial *> &materials, const StringName &p_name, const Variant &p_value)
+{
+    Variant::Type type = p_value.get_type();
+    bool sampler = type == Variant::OBJECT || type == Variant::NIL || type >= Variant::ARRAY;  // Arrays can't be instance uniforms either
+    if (use_instance_uniforms && !sampler) {
+        set_instance_shader_parameter(p_name, p_value);
+        for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+            if (split_screen_views[i].proxy) {
+                split_screen_views[i].proxy->set_instance_shader_parameter(p_name, p_value);
+            }
+        }
+        return;
+    }
+
+    for (uint32_t i = 0; i < materials.size(); i++) {
+        materials[i]->set_shader_parameter(p_name, p_value);
+    }
+}
+
+/**
+ * @brief Updates reflection camera projection to match main camera
+ */
+void PlanarReflectorCPP::update_camera_projection()
+{
+    Camera3D *active_cam = get_active_camera();
+    if (!active_cam || !reflect_camera) {
+        return;
+    }
+
+    // Auto-detect projection first so the scroll cache sees the final mode
+    if (auto_detect_camera_mode) {
+        reflect_camera->set_projection(active_cam->get_projection());
+    }
+
+    // Orthogonal size includes the scroll cache margin
+    copy_camera_projection(active_cam, reflect_camera, get_ortho_cache_extent_scale());
+    apply_prediction_overscan(reflect_camera);
+}
+
+/**
+ * @brief Copies projection settings from a source camera to a reflection camera
+ * 
+ * @param source_cam The camera being mirrored
+ * @param target_cam The reflection camera to configure
+ * @param extent_scale Extra scale for the orthogonal size (scroll cache margin)
+ */
+void PlanarReflectorCPP::copy_camera_projection(Camera3D *source_cam, Camera3D *target_cam, double extent_scale)
+{
+    // Auto-detect and match main camera projection type
+    if (auto_detect_camera_mode) {
+        target_cam->set_projection(source_cam->get_projection());
+    }
+    
+    // Configure projection-specific parameters
+    if (target_cam->get_projection() == Camera3D::PROJECTION_ORTHOGONAL) {
+        // Orthogonal: copy and scale the view size
+        target_cam->set_size(source_cam->get_size() * ortho_scale_multiplier * extent_scale);
+    } else {
+        // Perspective: copy the field of view
+        target_cam->set_fov(source_cam->get_fov());
+    }
+}
+
+/**
+ * @brief Whether the orthographic scroll cache applies to the current projection
+ */
+bool PlanarReflectorCPP::is_ortho_scroll_cache_active() const
+{
+    return ortho_scroll_cache && reflect_camera && reflect_camera->get_projection() == Camera3D::PROJECTION_ORTHOGONAL;
+}
+
+/**
+ * @brief Size of the cached orthogonal render relative to the visible view
+ * 
+ * @return double 1.0 when the cache is off, otherwise 1 + 2 * margin
+ */
+double PlanarReflectorCPP::get_ortho_cache_extent_scale() const
+{
+    return is_ortho_scroll_cache_active() ? 1.0 + 2.0 * ortho_cache_margin : 1.0;
+}
+
+/**
+ * @brief World-space width and height covered by an orthogonal camera
+ * 
+ * Camera3D::size is the height for KEEP_HEIGHT and the width for KEEP_WIDTH,
+ * the other axis follows the viewport aspect ratio.
+ */
+Vector2 PlanarReflectorCPP::get_ortho_view_extent(Camera3D *cam) const
+{
+    Vector2 viewport_size = cam->get_viewport() ? cam->get_viewport()->get_visible_rect().size : Vector2(1.0, 1.0);
+    double aspect = viewport_size.y > 0.0 ? viewport_size.x / viewport_size.y : 1.0;
+    double size = cam->get_size() * ortho_scale_multiplier;
+
+    if (cam->get_keep_aspect_mode() == Camera3D::KEEP_WIDTH) {
+        return Vector2(size, size / aspect);
+    }
+    return Vector2(size * aspect, size);
+}
+
+/**
+ * @brief Checks whether the cached orthogonal render still covers the view
+ * 
+ * In orthogonal projection a pan over a static scene only translates the
+ * reflection image. As long as the camera keeps its rotation and size and
+ * has moved less than the cached margin, the shader scrolls the UVs and no
+ * new render is needed.
+ * 
+ * @param active_cam The camera being mirrored
+ * @return bool True if the cache is still valid and ortho_scroll_offset was updated
+ */
+bool PlanarReflectorCPP::update_ortho_scroll_cache(Camera3D *active_cam)
+{
+    if (!ortho_cache_valid || reflection_cache_dirty) {
+        return false;
+    }
+
+    Transform3D cam_transform = active_cam->get_global_transform();
+
+    // Rotation, zoom or a moved reflector change the image itself
+    if (!cam_transform.basis.is_equal_approx(ortho_cache_camera_transform.basis) ||
+        !Math::is_equal_approx(active_cam->get_size(), ortho_cache_camera_size) ||
+        !cached_reflection_plane.is_equal_approx(ortho_cache_plane)) {
+        return false;
+    }
+
+    // Pan in view units along the camera's right and up axes (depth does not matter in ortho)
+    Vector2 view_extent = get_ortho_view_extent(active_cam);
+    Vector3 delta = cam_transform.origin - ortho_cache_camera_transform.origin;
+    Vector2 pan = Vector2(
+        delta.dot(cam_transform.basis.get_column(0).normalized()) / view_extent.x,
+        delta.dot(cam_transform.basis.get_column(1).normalized()) / view_extent.y);
+
+    // View left the cached margin - a new render is required
+    if (Math::abs(pan.x) > ortho_cache_margin || Math::abs(pan.y) > ortho_cache_margin) {
+        return false;
+    }
+
+    // Offset in texture UVs of the oversized render
+    ortho_scroll_offset = pan / get_ortho_cache_extent_scale();
+    return true;
+}
+
+/**
+ * @brief Centers the scroll cache on the current view and schedules one render
+ */
+void PlanarReflectorCPP::anchor_ortho_scroll_cache(Camera3D *active_cam)
+{
+    ortho_cache_camera_transform = active_cam->get_global_transform();
+    ortho_cache_camera_size = active_cam->get_size();
+    ortho_cache_plane = cached_reflection_plane;
+    ortho_scroll_offset = Vector2();
+    ortho_cache_valid = true;
+    reflection_cache_dirty = false;
+    request_reflection_render();
+}
+
+/**
+ * @brief Whether the viewport renders only when explicitly requested
+ */
+bool PlanarReflectorCPP::uses_on_demand_rendering() const
+{
+    return is_ortho_scroll_cache_active() || static_until_changed;
+}
+
+/**
+ * @brief Schedules a single render of the reflection viewport
+ */
+void PlanarReflectorCPP::request_reflection_render()
+{
+    reflection_render_requested = true;
+    wake_reflector();  // Property changes and content invalidation need a frame to act on
+}
+
+/**
+ * @brief Marks cached reflection content as stale so the next update re-renders
+ * 
+ * Call this when objects visible in the reflection change while a caching
+ * mode (such as the orthographic scroll cache) is active.
+ */
+void PlanarReflectorCPP::invalidate_reflection_cache()
+{
+    reflection_cache_dirty = true;
+    request_reflection_render();
+}
+
+/**
+ * @brief Applies continuous or on-demand rendering to the reflection viewport
+ * 
+ * Continuous mode keeps UPDATE_ALWAYS. On-demand modes render once when
+ * requested and stay disabled otherwise.
+ */
+void PlanarReflectorCPP::apply_viewport_update_mode()
+{
+    // Prewarm owns the update mode until its single render is drawn
+    if (!reflect_viewport || prewarm_in_progress) {
+        return;
+    }
+
+    SubViewport::UpdateMode mode = SubViewport::UPDATE_ALWAYS;
+    if (budget_evicted || reflection_empty || reflection_occluded || pvs_culled) {
+        mode = SubViewport::UPDATE_DISABLED;  // Nothing to render into / nothing to render / nothing to see
+    } else if (uses_on_demand_rendering()) {
+        mode = reflection_render_requested ? SubViewport::UPDATE_ONCE : SubViewport::UPDATE_DISABLED;
+    }
+    reflection_render_requested = false;
+
+    // Double-buffered: each update renders once into the back buffer, then swaps
+    bool swap_after_render = mode != SubViewport::UPDATE_DISABLED && is_double_buffering_active();
+    if (swap_after_render) {
+        mode = SubViewport::UPDATE_ONCE;
+        buffer_swap_pending = true;
+        buffer_render_frame = frame_counter;
+    }
+
+    // Continuous renders are counted per frame in accumulate_render_cost
+    if (mode == SubViewport::UPDATE_ONCE) {
+        count_reflection_render(reflect_viewport->get_size());
+    }
+
+    // Remember what the upcoming render shows for the static-mode checks
+    if (mode != SubViewport::UPDATE_DISABLED) {
+        time_since_render = 0.0;
+        if (reflect_camera) {
+            last_rendered_reflection_transform = reflect_camera->get_global_transform();
+        }
+    }
+
+    // Interleaved rendering alternates single renders per phase every frame
+    if (mode == SubViewport::UPDATE_ALWAYS && is_interleaving_active()) {
+        return;
+    }
+
+    // Every requested single render is scheduled again - the mode read back stays UPDATE_ONCE
+    if (mode == SubViewport::UPDATE_ONCE) {
+        render_reflection_once();
+        return;
+    }
+
+    // A pending single render must complete before the viewport is disabled
+    if (mode == SubViewport::UPDATE_DISABLED && is_single_render_pending()) {
+        return;
+    }
+
+    if (reflect_viewport->get_update_mode() != mode) {
+        reflect_viewport->set_update_mode(mode);
+    }
+}
+
+/**
+ * @brief Schedules one render of the reflection target at the end of this frame
+ * 
+ * The RenderingServer disables the viewport again after drawing it, while
+ * the SubViewport keeps reporting UPDATE_ONCE - so the mode is always set
+ * and the request frame remembered for is_single_render_pending().
+ */
+void PlanarReflectorCPP::render_reflection_once()
+{
+    reflect_viewport->set_update_mode(SubViewport::UPDATE_ONCE);
+    single_render_frame = Engine::get_singleton()->get_process_frames();
+}
+
+/**
+ * @brief Whether a single render was requested this frame and is not drawn yet
+ */
+bool PlanarReflectorCPP::is_single_render_pending() const
+{
+    return single_render_frame == Engine::get_singleton()->get_process_frames();
+}
+
+/**
+ * @brief The pose cache needs static renders in a standalone, swappable target
+ */
+bool PlanarReflectorCPP::is_pose_cache_active() const
+{
+    return pose_cache && static_until_changed && reflect_viewport && !budget_evicted &&
+            !front_buffer_viewport && !interleave_viewport;
+}
+
+/**
+ * @brief Everything that decides what a static render shows
+ * 
+ * The mirrored camera transform covers both the camera pose and the
+ * reflector plane; the reflector transform is added for the clip planes.
+ * Values are quantized so a camera returning to a fixed angle hits.
+ * The whole key is kept with each entry - a hash alone can collide and
+ * show another pose's image.
+ */
+Array PlanarReflectorCPP::compute_pose_key(const Transform3D &reflection_transform) const
+{
+    Array values;
+    Transform3D reflector_transform = get_global_transform();
+    const Transform3D *transforms[2] = { &reflection_transform, &reflector_transform };
+    for (int t = 0; t < 2; t++) {
+        Vector3 origin = transforms[t]->origin / POSE_CACHE_POSITION_STEP;
+        values.push_back(Vector3i(Math::round(origin.x), Math::round(origin.y), Math::round(origin.z)));
+        for (int column = 0; column < 3; column++) {
+            Vector3 axis = transforms[t]->basis.get_column(column) / POSE_CACHE_ROTATION_STEP;
+            values.push_back(Vector3i(Math::round(axis.x), Math::round(axis.y), Math::round(axis.z)));
+        }
+    }
+
+    values.push_back(reflect_viewport->get_size());
+    values.push_back(reflect_camera->get_projection());
+    values.push_back((int64_t)Math::round(reflect_camera->get_fov() * 100.0));
+    values.push_back((int64_t)Math::round(reflect_camera->get_size() * 100.0));
+    values.push_back(reflection_layers);
+    return values;
+}
+
+/**
+ * @brief Swaps in a cached render for this pose, parking the one shown now
+ * 
+ * On a miss with a finished render on screen, that render is parked and a
+ * spare target (new, or the least recently used entry when over the memory
+ * cap) takes its place for the new pose. On a hit the cached target becomes
+ * the live one and no render is scheduled.
+ * 
+ * @return bool True on a cache hit - the caller must not request a render
+ */
+bool PlanarReflectorCPP::use_cached_pose(const Transform3D &reflection_transform)
+{
+    if (!is_pose_cache_active()) {
+        return false;
+    }
+
+    Array key = compute_pose_key(reflection_transform);
+    uint32_t key_hash = key.hash();
+    uint64_t now = Time::get_singleton()->get_ticks_usec();
+
+    int64_t hit = -1;
+    for (uint32_t i = 0; i < pose_cache_entries.size(); i++) {
+        if (pose_cache_entries[i].key_hash == key_hash && pose_cache_entries[i].key == key) {
+            hit = i;
+            break;
+        }
+    }
+
+    // Too old to trust - max_staleness applies to cached renders as well
+    if (hit >= 0 && max_staleness > 0.0 && (double)(now - pose_cache_entries[hit].render_usec) / 1000000.0 >= max_staleness) {
+        free_pose_cache_rig(pose_cache_entries[hit]);
+        pose_cache_entries.remove_at(hit);
+        hit = -1;
+    }
+
+    // The render shown now is only worth keeping once it has completed
+    bool keep_current = current_pose_valid && !is_single_render_pending();
+    if (hit < 0 && !keep_current) {
+        current_pose_key = key;
+        current_pose_key_hash = key_hash;
+        current_pose_valid = true;
+        current_pose_render_usec = now;
+        return false;  // Render the new pose in place
+    }
+
+    PoseCacheEntry incoming;
+    if (hit >= 0) {
+        incoming = pose_cache_entries[hit];
+        pose_cache_entries.remove_at(hit);
+    } else {
+        incoming = acquire_pose_cache_rig();
+    }
+
+    // Park (or drop) the live target, the incoming one inherits its camera state
+    PoseCacheEntry outgoing;
+    outgoing.key = current_pose_key;
+    outgoing.key_hash = current_pose_key_hash;
+    outgoing.viewport = reflect_viewport;
+    outgoing.camera = reflect_camera;
+    outgoing.last_used_usec = now;
+    outgoing.render_usec = current_pose_render_usec;
+
+    Camera3D *camera = incoming.camera;
+    camera->set_environment(reflect_camera->get_environment());
+    camera->set_compositor(reflect_camera->get_compositor());
+    camera->set_cull_mask(reflect_camera->get_cull_mask());
+    camera->set_projection(reflect_camera->get_projection());
+    camera->set_fov(reflect_camera->get_fov());
+    camera->set_size(reflect_camera->get_size());
+    camera->set_near(reflect_camera->get_near());
+    camera->set_far(reflect_camera->get_far());
+    camera->set_global_transform(reflect_camera->get_global_transform());
+
+    int shadow_atlas_size = reflect_viewport->get_positional_shadow_atlas_size();
+    Vector2i target_size = reflect_viewport->get_size();
+    reflect_viewport = incoming.viewport;
+    reflect_camera = incoming.camera;
+    reflect_viewport->set_positional_shadow_atlas_size(shadow_atlas_size);
+    if (reflect_viewport->get_size() != target_size) {
+        reflect_viewport->set_size(target_size);
+    }
+
+    if (keep_current) {
+        outgoing.viewport->set_update_mode(SubViewport::UPDATE_DISABLED);
+        outgoing.viewport->set_positional_shadow_atlas_size(0);  // Parked targets never render
+        pose_cache_entries.push_back(outgoing);
+    } else {
+        free_pose_cache_rig(outgoing);
+    }
+    trim_pose_cache();
+
+    current_pose_key = key;
+    current_pose_key_hash = key_hash;
+    current_pose_valid = true;
+    if (hit < 0) {
+        current_pose_render_usec = now;
+        return false;
+    }
+
+    // Hit - show the cached image, cancel any render requested for this view
+    current_pose_render_usec = incoming.render_usec;
+    reflection_render_requested = false;
+    reflect_viewport->set_update_mode(SubViewport::UPDATE_DISABLED);
+    last_rendered_reflection_transform = reflection_transform;
+    time_since_render = (double)(now - incoming.render_usec) / 1000000.0;
+    return true;
+}
+
+/**
+ * @brief A target to render a new pose into - the LRU entry when over the cap, else a new one
+ */
+PlanarReflectorCPP::PoseCacheEntry PlanarReflectorCPP::acquire_pose_cache_rig()
+{
+    Vector2i size = reflect_viewport->get_size();
+    int64_t bytes_needed = (int64_t)size.x * (int64_t)size.y * 16;
+    int64_t limit = (int64_t)pose_cache_memory_mb * 1024 * 1024;
+
+    PoseCacheEntry entry;
+    if (!pose_cache_entries.is_empty() && get_pose_cache_bytes() + bytes_needed > limit) {
+        uint32_t oldest = 0;
+        for (uint32_t i = 1; i < pose_cache_entries.size(); i++) {
+            if (pose_cache_entries[i].last_used_usec < pose_cache_entries[oldest].last_used_usec) {
+                oldest = i;
+            }
+        }
+        entry = pose_cache_entries[oldest];
+        pose_cache_entries.remove_at(oldest);
+        return entry;
+    }
+
+    entry.viewport = create_reflection_subviewport("ReflectionViewPortPose", entry.camera);
+    entry.viewport->set_update_mode(SubViewport::UPDATE_DISABLED);
+    return entry;
+}
+
+/**
+ * @brief Frees least recently used entries until the parked renders fit the memory cap
+ */
+void PlanarReflectorCPP::trim_pose_cache()
+{
+    int64_t limit = (int64_t)pose_cache_memory_mb * 1024 * 1024;
+    while (!pose_cache_entries.is_empty() && get_pose_cache_bytes() > limit) {
+        uint32_t oldest = 0;
+        for (uint32_t i = 1; i < pose_cache_entries.size(); i++) {
+            if (pose_cache_entries[i].last_used_usec < pose_cache_entries[oldest].last_used_usec) {
+                oldest = i;
+            }
+        }
+        free_pose_cache_rig(pose_cache_entries[oldest]);
+        pose_cache_entries.remove_at(oldest);
+    }
+}
+
+/**
+ * @brief Drops every parked render (content changed, or the cache no longer applies)
+ */
+void PlanarReflectorCPP::flush_pose_cache()
+{
+    for (uint32_t i = 0; i < pose_cache_entries.size(); i++) {
+        free_pose_cache_rig(pose_cache_entries[i]);
+    }
+    pose_cache_entries.clear();
+    current_pose_valid = false;
+}
+
+void PlanarReflectorCPP::free_pose_cache_rig(PoseCacheEntry &entry)
+{
+    if (entry.viewport) {
+        if (entry.viewport->is_inside_tree()) {
+            entry.viewport->get_parent()->remove_child(entry.viewport);
+        }
+        entry.viewport->queue_free();
+    }
+    entry.viewport = nullptr;
+    entry.camera = nullptr;
+}
+
+/**
+ * @brief Approximate memory held by parked renders (color + depth)
+ */
+int64_t PlanarReflectorCPP::get_pose_cache_bytes() const
+{
+    int64_t bytes = 0;
+    for (uint32_t i = 0; i < pose_cache_entries.size(); i++) {
+        Vector2i size = pose_cache_entries[i].viewport->get_size();
+        bytes += (int64_t)size.x * (int64_t)size.y * 16;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Reads the shared content log and reports changes visible in the reflection
+ * 
+ * Geometry counts as changed only when its old or new bounds overlap the
+ * mirrored frustum. Any light change counts, since lighting affects the
+ * whole reflection. The nodes themselves are compared once per frame by
+ * content_tracker, so the cost here is one frustum test per changed node.
+ * 
+ * @return bool True if the reflection must be re-rendered
+ */
+bool PlanarReflectorCPP::detect_tracked_content_changes()
+{
+    bool changed = content_changed_pending;
+    content_changed_pending = false;
+
+    if (!content_tracker_acquired) {
+        return changed;
+    }
+
+    content_tracker.poll();
+    trim_content_log();
+
+    uint64_t log_end = content_tracker.get_log_end();
+    if (!reflect_camera || !content_tracker.is_cursor_valid(content_change_cursor)) {
+        content_change_cursor = log_end;
+        return true;  // Entries we never read were trimmed - assume something changed
+    }
+
+    TypedArray<Plane> frustum = reflect_camera->get_frustum();
+    for (; content_change_cursor < log_end && !changed; content_change_cursor++) {
+        const ReflectionContentTracker::Change &change = content_tracker.get_change(content_change_cursor);
+        if (!is_tracked_for_reflection(change.instance_id, change.is_light, change.layer_mask, change.reflector_id)) {
+            continue;
+        }
+
+        // Lights affect the whole reflection regardless of where they are
+        if (change.is_light) {
+            changed = true;
+            continue;
+        }
+
+        // Moving into, out of or inside the mirrored frustum changes the reflection
+        bool was_reflected = change.was_visible && is_aabb_in_reflection_frustum(change.old_world_aabb, frustum);
+        bool is_reflected = change.is_visible && is_aabb_in_reflection_frustum(change.new_world_aabb, frustum);
+        changed = was_reflected || is_reflected;
+    }
+
+    content_change_cursor = log_end;
+    return changed;
+}
+
+/**
+ * @brief Conservative AABB vs frustum test (false only if fully outside one plane)
+ * 
+ * @param world_aabb Bounds in world space
+ * @param frustum Planes from Camera3D::get_frustum(), normals pointing outward
+ */
+bool PlanarReflectorCPP::is_aabb_in_reflection_frustum(const AABB &world_aabb, const TypedArray<Plane> &frustum) const
+{
+    for (int i = 0; i < frustum.size(); i++) {
+        Plane plane = frustum[i];
+        bool all_outside = true;
+        for (int corner = 0; corner < 8; corner++) {
+            if (!plane.is_point_over(world_aabb.get_endpoint(corner))) {
+                all_outside = false;
+                break;
+            }
+        }
+        if (all_outside) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Whether a tracked node can affect this reflection
+ * 
+ * Manually registered nodes always count. With auto tracking, so do lights
+ * and geometry on reflection_layers - except the reflector itself and its rig.
+ */
+bool PlanarReflectorCPP::is_tracked_for_reflection(uint64_t instance_id, bool is_light, uint32_t layer_mask, uint64_t reflector_id) const
+{
+    if (manual_tracked_ids.find(instance_id) >= 0) {
+        return true;
+    }
+    if (!auto_track_reflected_nodes || reflector_id == get_instance_id()) {
+        return false;
+    }
+    return is_light || (layer_mask & reflection_layers);
+}
+
+/**
+ * @brief Joins the shared content tracker, starting it for the first static reflector
+ * 
+ * The first user walks the scene once and connects the tree signals; later
+ * users only register their manual nodes and read the log from its end.
+ */
+void PlanarReflectorCPP::acquire_content_tracker()
+{
+    if (content_tracker_acquired || !is_inside_tree()) {
+        return;
+    }
+
+    if (content_tracker_users == 0) {
+        Node *scene_root = Engine::get_singleton()->is_editor_hint() ? get_tree()->get_edited_scene_root() : get_tree()->get_current_scene();
+        if (!scene_root) {
+            scene_root = get_tree()->get_root();
+        }
+        content_tracker.start(scene_root);
+        get_tree()->connect("node_added", callable_mp_static(&PlanarReflectorCPP::on_scene_node_added));
+        get_tree()->connect("node_removed", callable_mp_static(&PlanarReflectorCPP::on_scene_node_removed));
+    }
+    content_tracker_users++;
+    content_tracker_acquired = true;
+
+    for (uint32_t i = 0; i < manual_tracked_ids.size(); i++) {
+        content_tracker.add_node(Object::cast_to<Node3D>(ObjectDB::get_instance(manual_tracked_ids[i])));
+    }
+    content_change_cursor = content_tracker.get_log_end();
+    content_changed_pending = true;
+}
+
+/**
+ * @brief Leaves the shared content tracker, stopping it with the last static reflector
+ */
+void PlanarReflectorCPP::release_content_tracker()
+{
+    if (!content_tracker_acquired) {
+        return;
+    }
+    content_tracker_acquired = false;
+    content_tracker_users--;
+
+    if (content_tracker_users == 0) {
+        content_tracker.stop();
+        SceneTree *tree = is_inside_tree() ? get_tree() : nullptr;
+        Callable added = callable_mp_static(&PlanarReflectorCPP::on_scene_node_added);
+        Callable removed = callable_mp_static(&PlanarReflectorCPP::on_scene_node_removed);
+        if (tree && tree->is_connected("node_added", added)) {
+            tree->disconnect("node_added", added);
+            tree->disconnect("node_removed", removed);
+        }
+    }
+}
+
+/**
+ * @brief Starts tracking newly spawned geometry and lights
+ */
+void PlanarReflectorCPP::on_scene_node_added(Node *node)
+{
+    if (ReflectionContentTracker::is_auto_trackable(node) && content_tracker.is_in_scene(node)) {
+        content_tracker.add_node(Object::cast_to<Node3D>(node));
+    }
+}
+
+/**
+ * @brief A tracked node leaving the tree is logged as a change and forgotten
+ */
+void PlanarReflectorCPP::on_scene_node_removed(Node *node)
+{
+    content_tracker.remove_node(node->get_instance_id());
+}
+
+/**
+ * @brief Drops log entries every static reflector has read
+ */
+void PlanarReflectorCPP::trim_content_log()
+{
+    uint64_t oldest_cursor = content_tracker.get_log_end();
+    for (uint32_t i = 0; i < registered_reflectors.size(); i++) {
+        if (registered_reflectors[i]->content_tracker_acquired) {
+            oldest_cursor = MIN(oldest_cursor, registered_reflectors[i]->content_change_cursor);
+        }
+    }
+    content_tracker.trim_log(oldest_cursor);
+}
+
+/**
+ * @brief Registers a node whose changes should re-render a static reflection
+ * 
+ * Use this for nodes outside reflection_layers that still affect the
+ * reflection, or when auto_track_reflected_nodes is disabled.
+ */
+void PlanarReflectorCPP::track_reflected_node(Node3D *p_node)
+{
+    if (!p_node || manual_tracked_ids.find(p_node->get_instance_id()) >= 0) {
+        return;
+    }
+
+    manual_tracked_ids.push_back(p_node->get_instance_id());
+    if (content_tracker_acquired) {
+        content_tracker.add_node(p_node);
+    }
+}
+
+void PlanarReflectorCPP::untrack_reflected_node(Node3D *p_node)
+{
+    if (p_node && manual_tracked_ids.find(p_node->get_instance_id()) >= 0) {
+        manual_tracked_ids.erase(p_node->get_instance_id());
+        content_changed_pending = true;
+    }
+}
+
+/**
+ * @brief Forgets manually registered nodes (auto tracking follows auto_track_reflected_nodes)
+ */
+void PlanarReflectorCPP::clear_tracked_nodes()
+{
+    manual_tracked_ids.clear();
+    content_changed_pending = true;
+}
+
+/**
+ * @brief Number of tracked nodes that can affect this reflection
+ */
+int PlanarReflectorCPP::get_tracked_node_count() const
+{
+    if (!content_tracker_acquired) {
+        return manual_tracked_ids.size();
+    }
+
+    int count = 0;
+    for (uint32_t i = 0; i < content_tracker.get_node_count(); i++) {
+        const ReflectionContentTracker::TrackedNode &tracked = content_tracker.get_node(i);
+        if (is_tracked_for_reflection(tracked.instance_id, tracked.is_light, tracked.last_layer_mask, tracked.reflector_id)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Whether the reflector's bounds are inside the camera frustum
+ */
+bool PlanarReflectorCPP::is_visible_to_camera(Camera3D *cam) const
+{
+    if (!cam || !is_visible_in_tree()) {
+        return false;
+    }
+    return is_aabb_in_reflection_frustum(get_global_transform().xform(get_aabb()), cam->get_frustum());
+}
+
+/**
+ * @brief Refreshes the cached visibility used for budget decisions
+ */
+void PlanarReflectorCPP::update_visibility_state()
+{
+    is_visible_to_active_camera = is_visible_to_camera(get_active_camera());
+    if (is_visible_to_active_camera) {
+        last_visible_usec = Time::get_singleton()->get_ticks_usec();
+    }
+}
+
+/**
+ * @brief Seconds since the reflector was last inside the active camera frustum
+ */
+double PlanarReflectorCPP::get_invisible_seconds() const
+{
+    if (is_visible_to_active_camera) {
+        return 0.0;
+    }
+    return (double)(Time::get_singleton()->get_ticks_usec() - last_visible_usec) / 1000000.0;
+}
+
+/**
+ * @brief Whether the shader should fall back to the environment-only look
+ */
+bool PlanarReflectorCPP::is_environment_only() const
+{
+    return budget_evicted || reflection_empty;
+}
+
+/**
+ * @brief Switches between the environment-only branch and full rendering
+ * 
+ * Runs after the reflection camera moved. Entering the empty state disables
+ * the viewport; leaving it invalidates the cache so the reflection renders
+ * again immediately, including in on-demand modes.
+ */
+void PlanarReflectorCPP::update_empty_reflection_state()
+{
+    bool empty = skip_empty_reflections && !has_reflected_geometry();
+    if (empty == reflection_empty) {
+        return;
+    }
+
+    reflection_empty = empty;
+    if (!reflection_empty) {
+        invalidate_reflection_cache();  // Geometry entered - render it now
+    }
+}
+
+/**
+ * @brief CPU-side query: does any visible geometry on reflection_layers intersect the mirrored frustum?
+ * 
+ * Uses the RenderingServer's scenario BVH, so the cost scales with what is
+ * near the frustum rather than with scene size. Geometry behind the mirror
+ * plane is counted too, since without hide_intersect_reflections it still
+ * shows up in the reflection.
+ */
+bool PlanarReflectorCPP::has_reflected_geometry() const
+{
+    if (!reflect_camera || !reflect_camera->is_inside_tree()) {
+        return true;  // Unknown - assume something is there
+    }
+
+    Ref<World3D> world = get_world_3d();
+    if (world.is_null()) {
+        return true;
+    }
+
+    TypedArray<Plane> frustum = reflect_camera->get_frustum();
+    PackedInt64Array instance_ids = RenderingServer::get_singleton()->instances_cull_convex(frustum, world->get_scenario());
+
+    uint64_t self_id = get_instance_id();
+    for (int64_t i = 0; i < instance_ids.size(); i++) {
+        if ((uint64_t)instance_ids[i] == self_id) {
+            continue;  // The reflector does not reflect itself
+        }
+
+        GeometryInstance3D *geometry = Object::cast_to<GeometryInstance3D>(ObjectDB::get_instance((uint64_t)instance_ids[i]));
+        if (geometry && (geometry->get_layer_mask() & (uint32_t)reflection_layers) && geometry->is_visible_in_tree()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PlanarReflectorCPP::is_reflection_empty() const { return reflection_empty; }
+
+/**
+ * @brief Tests the reflector against the shared occlusion buffer, with hysteresis
+ * 
+ * Rendering stops only after OCCLUSION_HIDE_FRAMES consecutive occluded
+ * frames, so a reflector flickering at an occluder's edge keeps rendering.
+ * While hidden, the test uses bounds grown by OCCLUSION_REVEAL_MARGIN, so
+ * the reflection renders a little before it actually comes into view.
+ */
+void PlanarReflectorCPP::update_occlusion_state()
+{
+    bool occluded = false;
+    Camera3D *active_cam = get_active_camera();
+    if (occlusion_culling && active_cam && active_cam->is_inside_tree()) {
+        build_occlusion_buffer(active_cam);
+        AABB bounds = get_global_transform().xform(get_aabb());
+        if (occlusion_buffer.is_occluded(bounds, reflection_occluded ? OCCLUSION_REVEAL_MARGIN : 0)) {
+            occlusion_hidden_frames++;
+            occluded = reflection_occluded || occlusion_hidden_frames >= OCCLUSION_HIDE_FRAMES;
+        } else {
+            occlusion_hidden_frames = 0;
+        }
+    } else {
+        occlusion_hidden_frames = 0;
+    }
+
+    if (occluded == reflection_occluded) {
+        return;
+    }
+    reflection_occluded = occluded;
+
+    if (reflection_occluded) {
+        apply_viewport_update_mode();
+        return;
+    }
+
+    // Revealed - the last render is stale, show the current view right away
+    invalidate_reflection_cache();
+    set_reflection_camera_transform();
+}
+
+/**
+ * @brief Rasterizes all occluders as seen from a camera (once per frame)
+ * 
+ * Sources are OccluderInstance3D nodes (their Occluder3D triangles) and
+ * MeshInstance3D nodes in the "reflection_occluders" group (low-poly
+ * stand-ins, faces cached per mesh). Reflectors never occlude anything.
+ */
+void PlanarReflectorCPP::build_occlusion_buffer(Camera3D *cam)
+{
+    uint64_t current_frame = Engine::get_singleton()->get_process_frames();
+    uint64_t camera_id = cam->get_instance_id();
+    if (current_frame == last_occlusion_pass_frame && camera_id == occlusion_camera_id) {
+        return;
+    }
+    last_occlusion_pass_frame = current_frame;
+    occlusion_camera_id = camera_id;
+
+    if (occluder_list_frame == 0 || current_frame - occluder_list_frame >= OCCLUDER_REFRESH_FRAMES) {
+        refresh_occluder_list(cam->get_tree());
+        occluder_list_frame = current_frame;
+    }
+
+    Projection view_projection = cam->get_camera_projection() * Projection(cam->get_camera_transform().affine_inverse());
+    occlusion_buffer.begin(view_projection);
+
+    for (uint32_t i = 0; i < occluder_node_ids.size(); i++) {
+        Node3D *node = Object::cast_to<Node3D>(ObjectDB::get_instance(occluder_node_ids[i]));
+        if (!node || !node->is_visible_in_tree() || Object::cast_to<PlanarReflectorCPP>(node)) {
+            continue;
+        }
+        occlusion_buffer.add_occluder_node(node, occluder_face_cache);
+    }
+}
+
+/**
+ * @brief Re-scans the tree for occluders (every OCCLUDER_REFRESH_FRAMES frames)
+ */
+void PlanarReflectorCPP::refresh_occluder_list(SceneTree *tree)
+{
+    occluder_face_cache.clear();  // Meshes may have been edited or freed
+    ReflectionOcclusionBuffer::collect_occluder_nodes(tree ? tree->get_root() : nullptr, occluder_node_ids);
+}
+
+bool PlanarReflectorCPP::is_reflection_occluded() const { return reflection_occluded; }
+
+/**
+ * @brief Culls every reflector outside the baked visibility set of the camera's cell
+ * 
+ * Runs at most once per process frame. While the camera stays in the same
+ * cell this is one grid lookup; the per-reflector bit tests only run when
+ * the cell changes or reflectors enter the tree.
+ */
+void PlanarReflectorCPP::apply_reflector_visibility_set(Camera3D *cam)
+{
+    if (visibility_set.is_null() || !cam) {
+        return;
+    }
+
+    uint64_t current_frame = Engine::get_singleton()->get_process_frames();
+    if (current_frame == last_visibility_pass_frame) {
+        return;
+    }
+    last_visibility_pass_frame = current_frame;
+
+    int cell = visibility_set->get_cell_index(cam->get_global_transform().origin);
+    if (cell == visibility_cell && !visibility_indices_dirty) {
+        return;
+    }
+    visibility_cell = cell;
+
+    bool resolve = visibility_indices_dirty;
+    visibility_indices_dirty = false;
+    for (uint32_t i = 0; i < registered_reflectors.size(); i++) {
+        PlanarReflectorCPP *reflector = registered_reflectors[i];
+        if (resolve) {
+            reflector->resolve_visibility_set_index();
+        }
+        bool culled = cell >= 0 && reflector->visibility_set_index >= 0 &&
+                !visibility_set->is_reflector_visible(cell, reflector->visibility_set_index);
+        reflector->set_pvs_culled(culled);
+    }
+}
+
+/**
+ * @brief Finds this reflector in the baked set by its path from the baked root
+ * 
+ * The set stores where its root sits in the scene, so a bake made on a
+ * sub-tree resolves the same paths at runtime.
+ */
+void PlanarReflectorCPP::resolve_visibility_set_index()
+{
+    visibility_set_index = -1;
+    if (visibility_set.is_null() || !is_inside_tree()) {
+        return;
+    }
+
+    Node *scene_root = get_tree()->get_current_scene();
+    if (Engine::get_singleton()->is_editor_hint()) {
+        scene_root = get_tree()->get_edited_scene_root();
+    }
+    Node *bake_root = visibility_set->find_bake_root(scene_root ? scene_root : get_tree()->get_root());
+    if (bake_root && (bake_root == this || bake_root->is_ancestor_of(this))) {
+        visibility_set_index = visibility_set->find_reflector(bake_root->get_path_to(this));
+    }
+}
+
+/**
+ * @brief Enters or leaves the baked-invisible state
+ * 
+ * Culled reflectors skip everything in process_reflection, including the
+ * per-reflector visibility and occlusion tests. Leaving the state renders
+ * the current view immediately.
+ */
+void PlanarReflectorCPP::set_pvs_culled(bool p_culled)
+{
+    if (pvs_culled == p_culled) {
+        return;
+    }
+    pvs_culled = p_culled;
+
+    if (pvs_culled) {
+        apply_viewport_update_mode();
+        return;
+    }
+
+    wake_reflector();
+    invalidate_reflection_cache();
+    if (reflect_viewport) {
+        set_reflection_camera_transform();
+    }
+}
+
+/**
+ * @brief Installs (or clears) the baked visibility set used by all reflectors
+ */
+void PlanarReflectorCPP::set_reflector_visibility_set(const Ref<ReflectorVisibilitySet> &p_set)
+{
+    visibility_set = p_set;
+    visibility_cell = -1;
+    visibility_indices_dirty = true;
+    last_visibility_pass_frame = 0;
+
+    // No set means nothing is culled by it
+    if (visibility_set.is_null()) {
+        for (uint32_t i = 0; i < registered_reflectors.size(); i++) {
+            registered_reflectors[i]->visibility_set_index = -1;
+            registered_reflectors[i]->set_pvs_culled(false);
+        }
+    }
+}
+
+Ref<ReflectorVisibilitySet> PlanarReflectorCPP::get_reflector_visibility_set() { return visibility_set; }
+
+/**
+ * @brief Releases static Refs while the engine can still free them
+ */
+void PlanarReflectorCPP::release_shared_resources()
+{
+    visibility_set.unref();
+    content_tracker.stop();
+}
+bool PlanarReflectorCPP::is_pvs_culled() const { return pvs_culled; }
+
+/**
+ * @brief Estimates GPU memory held by this reflector's rig
+ * 
+ * Approximation of what Godot allocates per 3D SubViewport:
+ * - Color: RGBA16F internal buffer + RGBA8 output texture (12 bytes/pixel)
+ * - Depth: 32-bit depth buffer (4 bytes/pixel)
+ * - Shadow: positional shadow atlas (16 or 32 bits per texel)
+ * - Compositor: one RGBA16F scratch buffer when the intersect effect runs
+ */
+void PlanarReflectorCPP::estimate_vram(int64_t &r_color, int64_t &r_depth, int64_t &r_shadow, int64_t &r_compositor) const
+{
+    r_color = 0;
+    r_depth = 0;
+    r_shadow = 0;
+    r_compositor = 0;
+
+    if (!reflect_viewport) {
+        return;
+    }
+
+    Vector2i size = reflect_viewport->get_size();
+    int64_t pixels = (int64_t)size.x * (int64_t)size.y;
+    r_color = pixels * 12;
+    r_depth = pixels * 4;
+
+    int64_t atlas_size = reflect_viewport->get_positional_shadow_atlas_size();
+    int64_t texel_bytes = reflect_viewport->get_positional_shadow_atlas_16_bits() ? 2 : 4;
+    r_shadow = atlas_size * atlas_size * texel_bytes;
+
+    // Split-screen targets carry the same per-pixel and shadow atlas costs
+    for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+        SubViewport *viewport = split_screen_views[i].viewport;
+        if (viewport) {
+            Vector2i view_size = viewport->get_size();
+            int64_t view_atlas = viewport->get_positional_shadow_atlas_size();
+            pixels += (int64_t)view_size.x * (int64_t)view_size.y;
+            r_color += (int64_t)view_size.x * (int64_t)view_size.y * 12;
+            r_depth += (int64_t)view_size.x * (int64_t)view_size.y * 4;
+            r_shadow += view_atlas * view_atlas * texel_bytes;
+        }
+    }
+
+    // Parked pose cache renders (never rendered again, so no shadow atlas)
+    for (uint32_t i = 0; i < pose_cache_entries.size(); i++) {
+        Vector2i pose_size = pose_cache_entries[i].viewport->get_size();
+        pixels += (int64_t)pose_size.x * (int64_t)pose_size.y;
+        r_color += (int64_t)pose_size.x * (int64_t)pose_size.y * 12;
+        r_depth += (int64_t)pose_size.x * (int64_t)pose_size.y * 4;
+    }
+
+    // Double-buffered front target
+    if (front_buffer_viewport) {
+        Vector2i front_size = front_buffer_viewport->get_size();
+        int64_t front_atlas = front_buffer_viewport->get_positional_shadow_atlas_size();
+        pixels += (int64_t)front_size.x * (int64_t)front_size.y;
+        r_color += (int64_t)front_size.x * (int64_t)front_size.y * 12;
+        r_depth += (int64_t)front_size.x * (int64_t)front_size.y * 4;
+        r_shadow += front_atlas * front_atlas * texel_bytes;
+    }
+
+    // Interleaved second phase target
+    if (interleave_viewport) {
+        Vector2i phase_size = interleave_viewport->get_size();
+        int64_t phase_atlas = interleave_viewport->get_positional_shadow_atlas_size();
+        pixels += (int64_t)phase_size.x * (int64_t)phase_size.y;
+        r_color += (int64_t)phase_size.x * (int64_t)phase_size.y * 12;
+        r_depth += (int64_t)phase_size.x * (int64_t)phase_size.y * 4;
+        r_shadow += phase_atlas * phase_atlas * texel_bytes;
+    }
+
+    if (active_compositor.is_valid() && hide_intersect_reflections) {
+        r_compositor = pixels * 8;
+    }
+}
+
+int64_t PlanarReflectorCPP::get_estimated_vram_bytes() const
+{
+    int64_t color, depth, shadow, compositor;
+    estimate_vram(color, depth, shadow, compositor);
+    return color + depth + shadow + compositor;
+}
+
+/**
+ * @brief Per-target VRAM estimate for profiling and memory reports
+ */
+Dictionary PlanarReflectorCPP::get_vram_usage_breakdown() const
+{
+    int64_t color, depth, shadow, compositor;
+    estimate_vram(color, depth, shadow, compositor);
+
+    Dictionary breakdown;
+    breakdown["color_bytes"] = color;
+    breakdown["depth_bytes"] = depth;
+    breakdown["shadow_atlas_bytes"] = shadow;
+    breakdown["compositor_bytes"] = compositor;
+    breakdown["total_bytes"] = color + depth + shadow + compositor;
+    breakdown["evicted"] = budget_evicted;
+    breakdown["visible"] = is_visible_to_active_camera;
+    breakdown["priority"] = reflection_priority;
+    return breakdown;
+}
+
+bool PlanarReflectorCPP::is_budget_evicted() const { return budget_evicted; }
+
+/**
+ * @brief Shrinks the rig to a minimal target and stops rendering
+ * 
+ * The shader receives reflection_environment_only so it can show the
+ * sky/environment look instead of the missing reflection.
+ */
+void PlanarReflectorCPP::evict_reflection_targets()
+{
+    if (budget_evicted || !reflect_viewport) {
+        return;
+    }
+
+    evicted_vram_bytes = get_estimated_vram_bytes();
+    budget_evicted = true;
+
+    // Second phase and back buffer targets are rebuilt by their sync after restore
+    free_interleave_rig();
+    free_double_buffer_rig();
+    flush_pose_cache();
+
+    // Smallest valid target releases the color, depth and shadow allocations
+    reflect_viewport->set_update_mode(SubViewport::UPDATE_DISABLED);
+    reflect_viewport->set_positional_shadow_atlas_size(0);
+    reflect_viewport->set_size(Vector2i(2, 2));
+
+    // Split-screen targets follow the primary rig
+    for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+        if (split_screen_views[i].viewport) {
+            split_screen_views[i].viewport->set_update_mode(SubViewport::UPDATE_DISABLED);
+            split_screen_views[i].viewport->set_positional_shadow_atlas_size(0);
+            split_screen_views[i].viewport->set_size(Vector2i(2, 2));
+        }
+    }
+
+    update_shader_parameters();
+}
+
+/**
+ * @brief Reallocates the full rig after the budget allows it again
+ */
+void PlanarReflectorCPP::restore_reflection_targets()
+{
+    if (!budget_evicted) {
+        return;
+    }
+
+    budget_evicted = false;
+    evicted_vram_bytes = 0;
+
+    if (reflect_viewport) {
+        reflect_viewport->set_positional_shadow_atlas_size(REFLECTION_SHADOW_ATLAS_SIZE);
+        last_viewport_check_frame = frame_counter - viewport_check_frequency;  // Resize immediately
+        update_reflect_viewport_size();
+        apply_viewport_update_mode();
+    }
+
+    for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+        if (split_screen_views[i].viewport) {
+            split_screen_views[i].viewport->set_positional_shadow_atlas_size(REFLECTION_SHADOW_ATLAS_SIZE);
+        }
+    }
+    update_split_screen_view_sizes();
+
+    update_shader_parameters();
+}
+
+/**
+ * @brief Detects discontinuities in the mirrored camera
+ * 
+ * A cut is a change of active camera, an explicit camera assignment, or a
+ * single-frame jump larger than camera_cut_distance / camera_cut_angle.
+ * Called every frame - only a transform compare, so it stays cheap.
+ * 
+ * @return bool True if the reflection must be refreshed immediately
+ */
+bool PlanarReflectorCPP::detect_camera_cut()
+{
+    Camera3D *active_cam = get_active_camera();
+    if (!active_cam) {
+        return false;
+    }
+
+    Transform3D cam_transform = active_cam->get_global_transform();
+    uint64_t camera_id = active_cam->get_instance_id();
+    bool cut = camera_cut_pending || camera_id != last_tracked_camera_id;
+
+    if (!cut) {
+        // Teleport: moved further than plausible in one frame
+        if (camera_cut_distance > 0.0 && cam_transform.origin.distance_to(last_camera_position) > camera_cut_distance) {
+            cut = true;
+        }
+        // Snap rotation: turned further than plausible in one frame
+        if (camera_cut_angle > 0.0) {
+            double angle = last_camera_rotation.get_rotation_quaternion().angle_to(cam_transform.basis.get_rotation_quaternion());
+            cut = cut || angle > Math::deg_to_rad(camera_cut_angle);
+        }
+    }
+
+    // Velocity across a cut is meaningless - start tracking again from the new view
+    if (cut) {
+        reset_camera_motion();
+    }
+
+    last_tracked_camera_id = camera_id;
+    last_camera_position = cam_transform.origin;
+    last_camera_rotation = cam_transform.basis;
+    camera_cut_pending = false;
+
+    return cut;
+}
+
+/**
+ * @brief Whether throttled updates should mirror an extrapolated camera pose
+ * 
+ * Only useful when renders are held for several frames on a schedule.
+ * Static and scroll-cached renders are held for arbitrary durations, so
+ * they keep mirroring the current pose.
+ */
+bool PlanarReflectorCPP::is_prediction_active() const
+{
+    return predictive_camera && update_frequency > 1 && !uses_on_demand_rendering();
+}
+
+/**
+ * @brief Updates the smoothed camera velocities from the pose at this reflection update
+ */
+void PlanarReflectorCPP::track_camera_motion(const Transform3D &cam_transform)
+{
+    uint64_t now = Time::get_singleton()->get_ticks_usec();
+    double dt = (double)(now - motion_sample_usec) / 1000000.0;
+
+    // First sample, or too old to describe the current motion
+    if (motion_sample_usec == 0 || dt <= 0.0 || dt > PREDICTION_MAX_SAMPLE_GAP) {
+        reset_camera_motion();
+        motion_sample_transform = cam_transform;
+        motion_sample_usec = now;
+        return;
+    }
+
+    Vector3 linear = (cam_transform.origin - motion_sample_transform.origin) / dt;
+
+    // Shortest rotation from the previous sample, as axis * angle per second
+    Quaternion delta = cam_transform.basis.get_rotation_quaternion() * motion_sample_transform.basis.get_rotation_quaternion().inverse();
+    if (delta.w < 0.0) {
+        delta = -delta;
+    }
+    Vector3 angular = Vector3();
+    double angle = delta.get_angle();
+    if (angle > CMP_EPSILON) {
+        angular = delta.get_axis().normalized() * (angle / dt);
+    }
+
+    // Smoothed so a single uneven frame doesn't throw the prediction
+    bool first_velocity = camera_update_interval <= 0.0;
+    camera_linear_velocity = first_velocity ? linear : camera_linear_velocity.lerp(linear, PREDICTION_SMOOTHING);
+    camera_angular_velocity = first_velocity ? angular : camera_angular_velocity.lerp(angular, PREDICTION_SMOOTHING);
+    camera_update_interval = first_velocity ? dt : Math::lerp(camera_update_interval, dt, PREDICTION_SMOOTHING);
+
+    motion_sample_transform = cam_transform;
+    motion_sample_usec = now;
+}
+
+void PlanarReflectorCPP::reset_camera_motion()
+{
+    motion_sample_usec = 0;
+    camera_linear_velocity = Vector3();
+    camera_angular_velocity = Vector3();
+    camera_update_interval = 0.0;
+}
+
+/**
+ * @brief Camera pose extrapolated to the middle of the interval this render is shown for
+ * 
+ * A render made now stays on screen until the next update, one measured
+ * update interval later. Mirroring the pose half-way through that interval
+ * halves the worst-case lag compared to mirroring the current pose.
+ */
+Transform3D PlanarReflectorCPP::get_predicted_camera_transform(Camera3D *cam) const
+{
+    Transform3D predicted = cam->get_global_transform();
+    if (camera_update_interval <= 0.0) {
+        return predicted;
+    }
+
+    double lead = Math::min(camera_update_interval * 0.5, PREDICTION_MAX_LEAD);
+    predicted.origin += camera_linear_velocity * lead;
+
+    double angular_speed = camera_angular_velocity.length();
+    if (angular_speed > CMP_EPSILON) {
+        Basis rotation(camera_angular_velocity / angular_speed, angular_speed * lead);
+        predicted.basis = (rotation * predicted.basis).orthonormalized();
+    }
+    return predicted;
+}
+
+/**
+ * @brief Widens the reflection camera by prediction_overscan
+ * 
+ * The margin lets the shader shift inside the render when the real camera
+ * ends up somewhere other than the prediction.
+ */
+void PlanarReflectorCPP::apply_prediction_overscan(Camera3D *cam) const
+{
+    if (!is_prediction_active() || prediction_overscan <= 0.0) {
+        return;
+    }
+
+    double scale = 1.0 + prediction_overscan;
+    if (cam->get_projection() == Camera3D::PROJECTION_ORTHOGONAL) {
+        cam->set_size(cam->get_size() * scale);
+        return;
+    }
+
+    double half_fov = Math::deg_to_rad(cam->get_fov()) * 0.5;
+    double widened = Math::rad_to_deg(2.0 * Math::atan(Math::tan(half_fov) * scale));
+    cam->set_fov(Math::min(widened, 179.0));
+}
+
+/**
+ * @brief Immediately resizes, re-mirrors and re-renders the reflection
+ * 
+ * Bypasses update_frequency, the periodic viewport size check, the LOD
+ * distance cache and any cached render so the very next frame shows the
+ * new viewpoint.
+ */
+void PlanarReflectorCPP::force_reflection_refresh()
+{
+    if (!reflect_viewport || !reflect_camera) {
+        return;
+    }
+
+    // Drop every cached decision that depends on the previous viewpoint
+    last_distance_check = -1.0;
+    last_viewport_check_frame = frame_counter - viewport_check_frequency;
+    ortho_cache_valid = false;
+
+    update_visibility_state();
+    update_reflect_viewport_size();
+    invalidate_reflection_cache();
+    set_reflection_camera_transform();
+    update_compositor_parameters();
+}
+
+/**
+ * @brief Creates missing split-screen rigs and drops views whose camera was freed
+ * 
+ * Extra views share the primary rig's environment and compositor, so only
+ * the render targets and shadow atlases are duplicated per player.
+ */
+void PlanarReflectorCPP::sync_split_screen_views()
+{
+    for (uint32_t i = 0; i < split_screen_views.size();) {
+        SplitScreenView &view = split_screen_views[i];
+        Camera3D *source = Object::cast_to<Camera3D>(ObjectDB::get_instance(view.camera_id));
+
+        // Player left - free the view
+        if (!source) {
+            free_split_screen_view(view);
+            free_split_screen_proxy(view);
+            split_screen_views.remove_at(i);
+            continue;
+        }
+
+        if (!view.viewport) {
+            view.viewport = create_reflection_subviewport("ReflectionViewPort" + itos(i + 1), view.camera);
+            view.viewport->set_update_mode(SubViewport::UPDATE_DISABLED);  // Rendered round-robin
+        }
+
+        // Keep the views consistent with the primary reflection camera
+        if (reflect_camera) {
+            if (view.camera->get_environment() != reflect_camera->get_environment()) {
+                view.camera->set_environment(reflect_camera->get_environment());
+            }
+            if (view.camera->get_compositor() != reflect_camera->get_compositor()) {
+                view.camera->set_compositor(reflect_camera->get_compositor());
+            }
+            view.camera->set_cull_mask(reflection_layers);
+        }
+        sync_split_screen_proxy(view, i + 1);
+        i++;
+    }
+    apply_split_screen_layers();
+}
+
+/**
+ * @brief Gives a player their own copy of the reflector mesh, on their own layer
+ * 
+ * Godot has no per-viewport uniforms, so the shader cannot tell which
+ * player's viewport it is drawing into. Instead every player sees a copy
+ * of the mesh on a layer only their camera renders, and the copy's
+ * reflection_view_index instance uniform selects their texture.
+ */
+void PlanarReflectorCPP::sync_split_screen_proxy(SplitScreenView &view, int view_index)
+{
+    if (!view.proxy) {
+        view.proxy = memnew(MeshInstance3D);
+        view.proxy->set_name("ReflectionViewProxy" + itos(view_index));
+        add_child(view.proxy);
+    }
+
+    // Same mesh and materials - the material holds every view's texture
+    if (view.proxy->get_mesh() != get_mesh()) {
+        view.proxy->set_mesh(get_mesh());
+    }
+    view.proxy->set_material_override(get_material_override());
+    for (int surface = 0; surface < get_surface_override_material_count(); surface++) {
+        view.proxy->set_surface_override_material(surface, get_surface_override_material(surface));
+    }
+    view.proxy->set_cast_shadows_setting(GeometryInstance3D::SHADOW_CASTING_SETTING_OFF);
+    view.proxy->set_layer_mask(get_split_screen_layer_bit(view_index));
+    view.proxy->set_instance_shader_parameter("reflection_view_index", view_index);
+}
+
+void PlanarReflectorCPP::free_split_screen_proxy(SplitScreenView &view)
+{
+    if (view.proxy) {
+        view.proxy->queue_free();
+    }
+    view.proxy = nullptr;
+}
+
+/**
+ * @brief Moves the reflector and each player camera onto the player's own layer
+ * 
+ * The reflector itself is view 0 on split_screen_first_layer. Every camera
+ * sees its own player layer and none of the others. Each camera's own cull
+ * mask is saved the first time it is changed and handed back once it is no
+ * longer a view (removed, or no longer the active camera). Without extra
+ * views the reflector and every camera get their own layers back.
+ */
+void PlanarReflectorCPP::apply_split_screen_layers()
+{
+    uint32_t player_bits = 0;
+    for (int view = 0; view <= MAX_SPLIT_SCREEN_VIEWS; view++) {
+        player_bits |= get_split_screen_layer_bit(view);
+    }
+    Camera3D *primary = get_active_camera();
+
+    if (split_screen_views.is_empty()) {
+        restore_split_screen_cull_masks(LocalVector<uint64_t>());
+        if (split_screen_layers_applied) {
+            split_screen_layers_applied = false;
+            set_layer_mask(split_screen_saved_layer_mask);
+        }
+        return;
+    }
+
+    if (!split_screen_layers_applied) {
+        split_screen_saved_layer_mask = get_layer_mask();
+        split_screen_layers_applied = true;
+    }
+    set_layer_mask(get_split_screen_layer_bit(0));
+    set_instance_shader_parameter("reflection_view_index", 0);
+
+    LocalVector<uint64_t> camera_ids;
+    for (uint32_t i = 0; i <= split_screen_views.size(); i++) {
+        Camera3D *camera = i == 0 ? primary : Object::cast_to<Camera3D>(ObjectDB::get_instance(split_screen_views[i - 1].camera_id));
+        if (!camera) {
+            continue;
+        }
+        uint64_t camera_id = camera->get_instance_id();
+        camera_ids.push_back(camera_id);
+        if (!split_screen_saved_cull_masks.has(camera_id)) {
+            split_screen_saved_cull_masks.insert(camera_id, camera->get_cull_mask());
+        }
+
+        uint32_t cull_mask = (split_screen_saved_cull_masks[camera_id] & ~player_bits) | get_split_screen_layer_bit(i);
+        if (camera->get_cull_mask() != cull_mask) {
+            camera->set_cull_mask(cull_mask);
+        }
+    }
+    restore_split_screen_cull_masks(camera_ids);
+}
+
+/**
+ * @brief Hands saved cull masks back to every camera that is no longer a view
+ * 
+ * @param keep_camera_ids Cameras still in use as views, left as they are
+ */
+void PlanarReflectorCPP::restore_split_screen_cull_masks(const LocalVector<uint64_t> &keep_camera_ids)
+{
+    LocalVector<uint64_t> released;
+    for (const KeyValue<uint64_t, uint32_t> &entry : split_screen_saved_cull_masks) {
+        if (keep_camera_ids.find(entry.key) < 0) {
+            released.push_back(entry.key);
+        }
+    }
+
+    for (uint32_t i = 0; i < released.size(); i++) {
+        Camera3D *camera = Object::cast_to<Camera3D>(ObjectDB::get_instance(released[i]));
+        if (camera) {
+            camera->set_cull_mask(split_screen_saved_cull_masks[released[i]]);
+        }
+        split_screen_saved_cull_masks.erase(released[i]);
+    }
+}
+
+/**
+ * @brief Render layer bit of a view's mesh (view 0 = the reflector itself)
+ */
+uint32_t PlanarReflectorCPP::get_split_screen_layer_bit(int view_index) const
+{
+    return 1u << (split_screen_first_layer - 1 + view_index);
+}
+
+/**
+ * @brief Sizes each split-screen target to its own camera's viewport
+ * 
+ * Each view gets distance LOD from its own camera and the roughness cap.
+ * If the extra views together exceed split_screen_pixel_budget, all of them
+ * are scaled down uniformly so adding players keeps the cost bounded.
+ */
+void PlanarReflectorCPP::update_split_screen_view_sizes()
+{
+    if (split_screen_views.is_empty() || budget_evicted) {
+        return;
+    }
+
+    LocalVector<Vector2i> target_sizes;
+    int64_t total_pixels = 0;
+
+    for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+        Camera3D *source = Object::cast_to<Camera3D>(ObjectDB::get_instance(split_screen_views[i].camera_id));
+        Vector2i target_size = reflection_camera_resolution;
+
+        if (source) {
+            if (source->get_viewport()) {
+                target_size = source->get_viewport()->get_visible_rect().size;
+            }
+            if (use_lod) {
+                double lod_factor = compute_lod_factor(get_global_transform().origin.distance_to(source->get_global_transform().origin));
+                target_size = Vector2i((double)target_size.x * lod_factor, (double)target_size.y * lod_factor);
+            }
+        }
+
+        target_size = apply_roughness_to_size(target_size);
+        target_sizes.push_back(target_size);
+        total_pixels += (int64_t)target_size.x * (int64_t)target_size.y;
+    }
+
+    // Shared pixel budget across all extra views
+    double budget_scale = 1.0;
+    if (split_screen_pixel_budget > 0 && total_pixels > split_screen_pixel_budget) {
+        budget_scale = Math::sqrt((double)split_screen_pixel_budget / (double)total_pixels);
+    }
+
+    for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+        SubViewport *viewport = split_screen_views[i].viewport;
+        if (!viewport) {
+            continue;
+        }
+
+        Vector2i size = Vector2i((double)target_sizes[i].x * budget_scale, (double)target_sizes[i].y * budget_scale);
+        size.x = Math::max(size.x, min_reflection_size);
+        size.y = Math::max(size.y, min_reflection_size);
+
+        if (viewport->get_size() != size) {
+            viewport->set_size(size);
+        }
+    }
+}
+
+/**
+ * @brief Mirrors and renders split-screen views, at most split_screen_updates_per_frame per frame
  * 
- * The reflection plane defines the mathematical surface across which
- * the camera view is mirrored. 
+ * Views are visited round-robin so every player gets updates at a steady
+ * rate. Views whose camera cannot see the reflector are skipped and stay
+ * disabled.
+ */
+void PlanarReflectorCPP::update_split_screen_views()
+{
+    if (split_screen_views.is_empty() || !reflect_camera || budget_evicted) {
+        return;
+    }
+
+    uint32_t view_count = split_screen_views.size();
+    int updates_left = split_screen_updates_per_frame;
+
+    for (uint32_t n = 0; n < view_count && updates_left > 0; n++) {
+        uint32_t index = (split_screen_next_update + n) % view_count;
+        SplitScreenView &view = split_screen_views[index];
+        Camera3D *source = Object::cast_to<Camera3D>(ObjectDB::get_instance(view.camera_id));
+
+        if (!source || !view.viewport || !is_visible_to_camera(source)) {
+            continue;
+        }
+
+        copy_camera_projection(source, view.camera, 1.0);
+        Transform3D view_transform = compute_reflection_transform(source, cached_reflection_plane);
+        view.camera->set_global_transform(view_transform);
+        fit_reflection_clip_planes(view.camera, view_transform, source);
+        view.viewport->set_update_mode(SubViewport::UPDATE_ONCE);
+        count_reflection_render(view.viewport->get_size());
+
+        updates_left--;
+        split_screen_next_update = (index + 1) % view_count;
+    }
+
+}
+
+/**
+ * @brief Hands every view's texture to the shader, indexed by reflection_view_index
  * 
- * @return Plane The reflection plane in world space
+ * Index 0 is the primary camera, index i + 1 split-screen view i. Each
+ * player's copy of the mesh carries its index as an instance uniform (see
+ * sync_split_screen_proxy), so the selection never depends on where the
+ * players stand.
  */
-Plane PlanarReflectorCPP::calculate_reflection_plane()
+void PlanarReflectorCPP::push_split_screen_shader_parameters(const LocalVector<ShaderMaterial *> &materials)
 {
-    if (!is_inside_tree()) {
-        return Plane();  // Return invalid plane if not in scene
+    if (split_screen_views.is_empty()) {
+        set_reflection_parameter(materials, "reflection_view_count", 1);
+        return;
     }
-        
-    Transform3D current_transform = get_global_transform();
-    
-    // Create reflection plane by rotating reflector transform 90 degrees around X
-    // This makes the "up" direction (Y) become the plane normal
-    Transform3D reflection_transform = current_transform * Transform3D().rotated(Vector3(1, 0, 0), Math_PI / 2.0);
-    
-    // Extract plane properties from the transformed basis
-    Vector3 plane_origin = reflection_transform.get_origin();           // Point on plane
-    Vector3 plane_normal = reflection_transform.get_basis().get_column(2).normalized();  // Plane normal
-    
-    // Create plane using normal and distance from origin
-    // Distance = normal • origin (dot product)
-    cached_reflection_plane = Plane(plane_normal, plane_origin.dot(plane_normal));
-    last_global_transform = current_transform;
-    
-    return cached_reflection_plane;
+
+    Array view_textures;
+    view_textures.push_back(reflect_viewport ? Variant(get_sampled_viewport()->get_texture()) : Variant());
+
+    // One entry per view, even without a target, so indices stay stable
+    for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+        SubViewport *viewport = split_screen_views[i].viewport;
+        view_textures.push_back(viewport ? Variant(viewport->get_texture()) : Variant());
+    }
+
+    set_reflection_parameter(materials, "reflection_view_count", view_textures.size());
+    set_reflection_parameter(materials, "reflection_view_textures", view_textures);
 }
 
 /**
- * @brief Updates reflection viewport size based on screen/editor size and LOD
+ * @brief Frees a split-screen rig (the camera goes with its viewport)
+ */
+void PlanarReflectorCPP::free_split_screen_view(SplitScreenView &view)
+{
+    if (view.viewport) {
+        if (view.viewport->is_inside_tree()) {
+            view.viewport->get_parent()->remove_child(view.viewport);
+        }
+        view.viewport->queue_free();
+    }
+    view.viewport = nullptr;
+    view.camera = nullptr;
+}
+
+/**
+ * @brief Adds a split-screen player camera with its own reflection target
  * 
- * Manages the resolution of the reflection viewport and sets the LOD system
+ * The primary camera (main_camera / editor camera) is always view 0 and
+ * should not be added here. Views are dropped when the reflector leaves
+ * the tree.
  */
-void PlanarReflectorCPP::update_reflect_viewport_size()
+void PlanarReflectorCPP::add_split_screen_camera(Camera3D *p_camera)
 {
-    if (!reflect_viewport) {
-        UtilityFunctions::print("[PlanarReflectorCPP] ERROR: update_reflect_viewport_size - reflect_viewport is null");
+    if (!p_camera || p_camera == get_active_camera()) {
         return;
     }
-    
-    // Performance optimization: only check size periodically
-    if (frame_counter - last_viewport_check_frame < viewport_check_frequency) {
+
+    uint64_t camera_id = p_camera->get_instance_id();
+    for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+        if (split_screen_views[i].camera_id == camera_id) {
+            return;  // Already added
+        }
+    }
+
+    if ((int)split_screen_views.size() >= MAX_SPLIT_SCREEN_VIEWS) {
+        UtilityFunctions::push_warning("[PlanarReflectorCPP] add_split_screen_camera: at most ", MAX_SPLIT_SCREEN_VIEWS, " extra cameras are supported");
         return;
     }
-    last_viewport_check_frame = frame_counter;
-    
-    // Get base target size from screen/editor
-    Vector2i target_size = get_target_viewport_size();
-    Camera3D *active_cam = get_active_camera();
-    
-    // Apply LOD scaling if enabled and we have an active camera
-    if (use_lod && active_cam) {
-        target_size = apply_lod_to_size(target_size, active_cam);
+
+    SplitScreenView view;
+    view.camera_id = camera_id;
+    split_screen_views.push_back(view);
+
+    // Build the rig now if the primary one already exists
+    if (reflect_viewport) {
+        sync_split_screen_views();
+        update_split_screen_view_sizes();
     }
+}
 
-    // Apply the calculated size to the viewport
-    reflect_viewport->set_size(target_size);
+void PlanarReflectorCPP::remove_split_screen_camera(Camera3D *p_camera)
+{
+    if (!p_camera) {
+        return;
+    }
+
+    uint64_t camera_id = p_camera->get_instance_id();
+    for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+        if (split_screen_views[i].camera_id == camera_id) {
+            free_split_screen_view(split_screen_views[i]);
+            free_split_screen_proxy(split_screen_views[i]);
+            split_screen_views.remove_at(i);
+            split_screen_next_update = 0;
+
+            // Later views moved down one index - their proxies follow
+            if (reflect_viewport) {
+                sync_split_screen_views();
+            } else {
+                apply_split_screen_layers();
+            }
+            update_shader_parameters();
+            return;
+        }
+    }
+}
+
+void PlanarReflectorCPP::clear_split_screen_cameras()
+{
+    for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+        free_split_screen_view(split_screen_views[i]);
+        free_split_screen_proxy(split_screen_views[i]);
+    }
+    split_screen_views.clear();
+    split_screen_next_update = 0;
+    apply_split_screen_layers();
+    update_shader_parameters();
+}
+
+TypedArray<Camera3D> PlanarReflectorCPP::get_split_screen_cameras() const
+{
+    TypedArray<Camera3D> cameras;
+    for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+        Camera3D *source = Object::cast_to<Camera3D>(ObjectDB::get_instance(split_screen_views[i].camera_id));
+        if (source) {
+            cameras.push_back(source);
+        }
+    }
+    return cameras;
 }
 
 /**
- * @brief Main reflection calculation - Updates camera transform and shader parameters
+ * @brief Allocates the rig on first visibility and releases it after a long invisibility
  * 
- * This is the core function that creates the reflection effect by:
- * 1. Calculating the reflection plane from the reflector's position
- * 2. Computing the mirrored camera position across the plane
- * 3. Creating a mirrored camera orientation (basis)
- * 4. Applying any configured offset adjustments
- * 5. Updating shader parameters with the new reflection data
+ * Lazy reflectors skip setup in _ready() and only pay for their SubViewport,
+ * camera and shadow atlas once the active camera actually sees them. With a
+ * release timeout, the rig is freed again after the reflector has been out of
+ * view for that long, and recreated the next time it becomes visible.
  */
-void PlanarReflectorCPP::set_reflection_camera_transform()
+void PlanarReflectorCPP::update_rig_lifetime()
 {
-    // Validate scene tree state
-    if (!is_inside_tree()) {
-        // UtilityFunctions::print("[PlanarReflectorCPP] ERROR: set_reflection_camera_transform stopped - Not Inside Tree");
+    // First (or renewed) visibility - build the rig
+    if (!rig_setup_started && is_visible_to_active_camera) {
+        rig_setup_started = true;
+        initial_setup();
         return;
     }
-        
-    // Validate required cameras exist
-    Camera3D *active_camera = get_active_camera();
-    if (!active_camera || !reflect_camera) {
-        UtilityFunctions::print("[PlanarReflectorCPP] Info: MIssing Camera or Reflect Camera not loaded. Reflections will not show.");
+
+    // Out of view for too long - give the memory back
+    if (rig_release_timeout > 0.0 && reflect_viewport && get_invisible_seconds() >= rig_release_timeout) {
+        release_reflection_rig();
+    }
+}
+
+/**
+ * @brief Frees the reflection SubViewport and camera, keeping all settings
+ * 
+ * The rig is rebuilt automatically when the reflector becomes visible again.
+ */
+void PlanarReflectorCPP::release_reflection_rig()
+{
+    // CRITICAL: Materials must not keep sampling the texture being freed
+    clear_shader_texture_references();
+
+    // Back buffer first - the front one is then freed as the primary target
+    free_double_buffer_rig();
+    flush_pose_cache();
+
+    if (reflect_viewport) {
+        if (reflect_viewport->is_inside_tree()) {
+            reflect_viewport->get_parent()->remove_child(reflect_viewport);
+        }
+        reflect_viewport->queue_free();
+        reflect_viewport = nullptr;
+    }
+    reflect_camera = nullptr;  // Freed together with its viewport
+
+    // Split-screen rigs are rebuilt together with the primary one
+    for (uint32_t i = 0; i < split_screen_views.size(); i++) {
+        free_split_screen_view(split_screen_views[i]);
+    }
+    free_interleave_rig();
+
+    // Fresh state for the next allocation
+    rig_setup_started = false;
+    prewarm_in_progress = false;
+    budget_evicted = false;
+    evicted_vram_bytes = 0;
+    ortho_cache_valid = false;
+    reflection_cache_dirty = true;
+}
+
+bool PlanarReflectorCPP::is_reflection_rig_allocated() const { return reflect_viewport != nullptr; }
+
+/**
+ * @brief Renders the reflection once, offscreen and tiny, so its pipelines compile now
+ * 
+ * The first render of a material/light combination and the first run of the
+ * reflection compositor effect compile pipelines, which hitches when a
+ * reflector first comes into view. Call this during loading (or enable
+ * prewarm_on_ready) so that cost is paid behind the loading screen. The
+ * render uses the reflection environment and compositor and mirrors the
+ * active camera, so what that view sees is compiled. Lazy reflectors build
+ * their rig for this. Poll is_prewarming() to wait for completion.
+ */
+void PlanarReflectorCPP::prewarm_reflection()
+{
+    // No rig yet - build it now, the prewarm runs when setup finishes
+    if (!reflect_viewport) {
+        prewarm_requested = true;
+        if (!rig_setup_started && is_inside_tree()) {
+            rig_setup_started = true;
+            initial_setup();
+        }
         return;
     }
-        
-    // Update camera projection settings to match main camera
-    update_camera_projection();
-    
-    // Calculate the mathematical reflection plane
-    Plane reflection_plane = calculate_reflection_plane();
-    
-    // STEP 1: Calculate mirrored camera position
-    Vector3 cam_pos = active_camera->get_global_transform().get_origin();
-    Vector3 proj_pos = reflection_plane.project(cam_pos);           // Project onto plane
-    Vector3 mirrored_pos = cam_pos + (proj_pos - cam_pos) * 2.0;    // Mirror across plane
-    
-    // STEP 2: Create base transform with mirrored position
-    Transform3D base_reflection_transform;
-    base_reflection_transform.set_origin(mirrored_pos);
-    
-    // STEP 3: Calculate mirrored camera orientation (basis)
-    Basis main_basis = active_camera->get_global_transform().get_basis();
-    Vector3 n = reflection_plane.get_normal();
-    
-    // Mirror each basis vector by bouncing it off the plane normal
-    // bounce() function: vector - 2 * (vector • normal) * normal
-    Basis reflection_basis;
-    reflection_basis.set_column(0, main_basis.get_column(0).normalized().bounce(n).normalized());  // Right vector
-    reflection_basis.set_column(1, main_basis.get_column(1).normalized().bounce(n).normalized());  // Up vector
-    reflection_basis.set_column(2, main_basis.get_column(2).normalized().bounce(n).normalized());  // Forward vector
-    
-    // STEP 4: Combine position and orientation and create base transform
-    base_reflection_transform.set_basis(reflection_basis);
-    Transform3D final_reflection_transform = base_reflection_transform;
-    
-    // STEP 5: Apply any configured offset adjustments
-    if(enable_reflection_offset) 
-    {
-        final_reflection_transform = apply_reflection_offset(base_reflection_transform);
+    start_prewarm_render();
+}
+
+bool PlanarReflectorCPP::is_prewarming() const { return prewarm_requested || prewarm_in_progress; }
+
+/**
+ * @brief Prewarms every reflector in the process - call while the loading screen is up
+ */
+void PlanarReflectorCPP::prewarm_all_reflectors()
+{
+    for (uint32_t i = 0; i < registered_reflectors.size(); i++) {
+        registered_reflectors[i]->prewarm_reflection();
     }
-        
-    // STEP 6: Set the calculated transform on the reflection camera
-    reflect_camera->set_global_transform(final_reflection_transform);
-    
-    // STEP 7: Update shader material with new reflection data
-    update_shader_parameters();
 }
 
 /**
- * @brief Updates shader material parameters with current reflection data
+ * @brief Shrinks the target and schedules the single prewarm render
  * 
- * Transfers reflection rendering data to the shader material that
- * displays the reflection effect.
+ * Pipelines depend on formats and features, not resolution, so a
+ * PREWARM_VIEWPORT_SIZE square target compiles the same ones as the
+ * full-size render. Evicted targets keep their size.
  */
-void PlanarReflectorCPP::update_shader_parameters()
+void PlanarReflectorCPP::start_prewarm_render()
 {
-    // Validate that we have surface materials to work with
-    if (get_surface_override_material_count() == 0) {
-        // UtilityFunctions::print("[PlanarReflectorCPP] ERROR: update_shader_parameters - No surface material");
+    prewarm_requested = false;
+    if (!reflect_viewport) {
         return;
     }
-    
-    // Get the first material and cast to ShaderMaterial
-    ShaderMaterial *material = Object::cast_to<ShaderMaterial>(get_active_material(0).ptr()); 
-    if (!material || !reflect_viewport) {
-        // UtilityFunctions::print("[PlanarReflectorCPP] Info: Please add a material and reload the scene to enable reflection.");
+
+    // Holds off size checks and update mode changes until the render is drawn
+    prewarm_in_progress = true;
+    if (!budget_evicted) {
+        reflect_viewport->set_size(Vector2i(PREWARM_VIEWPORT_SIZE, PREWARM_VIEWPORT_SIZE));
+    }
+
+    // Mirror the active camera (if any) so the materials it sees get compiled
+    set_reflection_camera_transform();
+
+    reflect_viewport->set_update_mode(SubViewport::UPDATE_ONCE);
+    prewarm_frame = Engine::get_singleton()->get_process_frames();
+    count_reflection_render(reflect_viewport->get_size());
+    wake_reflector();
+}
+
+/**
+ * @brief Restores the real target size and schedule once the prewarm render is drawn
+ * 
+ * The render is drawn at the end of the frame it was scheduled in, so any
+ * later process frame may finish. The viewport's update mode can't tell -
+ * it keeps reporting UPDATE_ONCE after drawing.
+ */
+void PlanarReflectorCPP::finish_prewarm_render()
+{
+    if (Engine::get_singleton()->get_process_frames() <= prewarm_frame) {
+        return;
+    }
+    prewarm_in_progress = false;
+    if (!reflect_viewport) {
         return;
     }
 
-    // Get the rendered reflection texture from viewport
-    Ref<Texture2D> reflection_texture = reflect_viewport->get_texture();
-    bool is_orthogonal = false;
-    
-    // Determine camera projection type for shader math
-    Camera3D *active_cam = get_active_camera();
-    if (active_cam) {
-        is_orthogonal = (active_cam->get_projection() == Camera3D::PROJECTION_ORTHOGONAL);
+    last_viewport_check_frame = frame_counter - viewport_check_frequency;
+    update_reflect_viewport_size();
+    invalidate_reflection_cache();  // The prewarm image is not a usable reflection
+    apply_viewport_update_mode();
+}
+
+/**
+ * @brief Eviction order - invisible first, then lower priority, then longest invisible
+ */
+bool PlanarReflectorCPP::is_less_important(const PlanarReflectorCPP *a, const PlanarReflectorCPP *b)
+{
+    if (a->is_visible_to_active_camera != b->is_visible_to_active_camera) {
+        return !a->is_visible_to_active_camera;
     }
-    
-    // Validate reflection texture quality
-    if(reflection_texture.is_null() || reflection_texture.is_valid() == false || 
-       reflection_texture->get_size() != reflect_viewport->get_size())
-    {
-        UtilityFunctions::print("[PlanarReflectorCPP] ERROR: update_shader_parameters - No valid texture found");
+    if (a->reflection_priority != b->reflection_priority) {
+        return a->reflection_priority < b->reflection_priority;
+    }
+    return a->get_invisible_seconds() > b->get_invisible_seconds();
+}
+
+/**
+ * @brief Keeps the sum of all reflection rigs under the global VRAM budget
+ * 
+ * Runs at most once per process frame, from whichever reflector reaches its
+ * periodic check first. Over budget, the least important reflectors are
+ * evicted one by one. Under 90% of the budget, the most important visible
+ * evicted reflector is restored (the gap avoids evict/restore ping-pong).
+ */
+void PlanarReflectorCPP::enforce_vram_budget()
+{
+    uint64_t current_frame = Engine::get_singleton()->get_process_frames();
+    if (current_frame == last_budget_pass_frame) {
+        return;
+    }
+    last_budget_pass_frame = current_frame;
+
+    // Unlimited budget - everything comes back
+    if (vram_budget_bytes <= 0) {
+        for (uint32_t i = 0; i < registered_reflectors.size(); i++) {
+            registered_reflectors[i]->restore_reflection_targets();
+        }
+        return;
+    }
+
+    int64_t total = get_total_reflection_vram();
+
+    // Over budget: evict least important until we fit
+    while (total > vram_budget_bytes) {
+        PlanarReflectorCPP *candidate = nullptr;
+        for (uint32_t i = 0; i < registered_reflectors.size(); i++) {
+            PlanarReflectorCPP *reflector = registered_reflectors[i];
+            if (reflector->budget_evicted || !reflector->reflect_viewport) {
+                continue;
+            }
+            if (!candidate || is_less_important(reflector, candidate)) {
+                candidate = reflector;
+            }
+        }
+
+        if (!candidate) {
+            break;  // Nothing left to evict
+        }
+
+        int64_t before = candidate->get_estimated_vram_bytes();
+        candidate->evict_reflection_targets();
+        total -= before - candidate->get_estimated_vram_bytes();
+    }
+
+    // Under budget: restore most important visible reflectors that fit with headroom
+    int64_t restore_limit = (int64_t)((double)vram_budget_bytes * 0.9);
+    while (true) {
+        PlanarReflectorCPP *candidate = nullptr;
+        for (uint32_t i = 0; i < registered_reflectors.size(); i++) {
+            PlanarReflectorCPP *reflector = registered_reflectors[i];
+            if (!reflector->budget_evicted || !reflector->is_visible_to_active_camera) {
+                continue;
+            }
+            if (!candidate || is_less_important(candidate, reflector)) {
+                candidate = reflector;
+            }
+        }
+
+        if (!candidate || total + candidate->evicted_vram_bytes > restore_limit) {
+            break;
+        }
+
+        int64_t before = candidate->get_estimated_vram_bytes();
+        candidate->restore_reflection_targets();
+        total += candidate->get_estimated_vram_bytes() - before;
     }
-    
-    // Update all shader parameters for reflection rendering
-    material->set_shader_parameter("reflection_screen_texture", reflection_texture);      // Main reflection image
-    material->set_shader_parameter("is_orthogonal_camera", is_orthogonal);              // Projection type flag
-    material->set_shader_parameter("ortho_uv_scale", ortho_uv_scale);                   // UV scaling for ortho
-    material->set_shader_parameter("reflection_offset_enabled", enable_reflection_offset); // Offset system flag
-    material->set_shader_parameter("reflection_offset_position", reflection_offset_position); // Position offset
-    material->set_shader_parameter("reflection_offset_scale", reflection_offset_scale);  // Scale offset
-    material->set_shader_parameter("reflection_plane_normal", cached_reflection_plane.get_normal()); // Plane normal vector
-    material->set_shader_parameter("reflection_plane_distance", cached_reflection_plane.d);      // Plane distance
-    material->set_shader_parameter("planar_surface_y", get_global_transform().get_origin().y);  // Surface height
 }
 
+void PlanarReflectorCPP::set_reflection_vram_budget(int64_t p_bytes) { vram_budget_bytes = Math::max(p_bytes, (int64_t)0); }
+int64_t PlanarReflectorCPP::get_reflection_vram_budget() { return vram_budget_bytes; }
+
 /**
- * @brief Updates reflection camera projection to match main camera
+ * @brief Sum of the estimated VRAM of every reflector in the process
  */
-void PlanarReflectorCPP::update_camera_projection()
+int64_t PlanarReflectorCPP::get_total_reflection_vram()
 {
-    Camera3D *active_cam = get_active_camera();
-    if (!active_cam || !reflect_camera) {
-        return;
-    }
-    
-    // Auto-detect and match main camera projection type
-    if (auto_detect_camera_mode) {
-        reflect_camera->set_projection(active_cam->get_projection());
+    int64_t total = 0;
+    for (uint32_t i = 0; i < registered_reflectors.size(); i++) {
+        total += registered_reflectors[i]->get_estimated_vram_bytes();
     }
-    
-    // Configure projection-specific parameters
-    if (reflect_camera->get_projection() == Camera3D::PROJECTION_ORTHOGONAL) {
-        // Orthogonal: copy and scale the view size
-        reflect_camera->set_size(active_cam->get_size() * ortho_scale_multiplier);
-    } else {
-        // Perspective: copy the field of view
-        reflect_camera->set_fov(active_cam->get_fov());
+    return total;
+}
+
+/**
+ * @brief One breakdown Dictionary per reflector, with its node path
+ */
+Array PlanarReflectorCPP::get_reflection_vram_report()
+{
+    Array report;
+    for (uint32_t i = 0; i < registered_reflectors.size(); i++) {
+        PlanarReflectorCPP *reflector = registered_reflectors[i];
+        Dictionary entry = reflector->get_vram_usage_breakdown();
+        entry["path"] = reflector->is_inside_tree() ? reflector->get_path() : NodePath();
+        report.push_back(entry);
     }
+    return report;
 }
 
 /**
@@ -653,16 +4214,16 @@ void PlanarReflectorCPP::update_camera_projection()
  */
 void PlanarReflectorCPP::clear_shader_texture_references()
 {
-    if (get_surface_override_material_count() == 0) {
+    LocalVector<ShaderMaterial *> materials;
+    if (!gather_reflection_materials(materials)) {
         return;
     }
 
-    Ref<Material> material = get_active_material(0);
-    if (material.is_valid() && Object::cast_to<ShaderMaterial>(material.ptr())) 
-    {
-        ShaderMaterial *shader_material = Object::cast_to<ShaderMaterial>(material.ptr());
-        shader_material->set_shader_parameter("reflection_screen_texture", Variant());
+    set_reflection_parameter(materials, "reflection_screen_texture", Variant());
+    if (!split_screen_views.is_empty()) {
+        set_reflection_parameter(materials, "reflection_view_textures", Array());
     }
+    set_reflection_parameter(materials, "reflection_phase_b_texture", Variant());
 }
 
 /**
@@ -760,18 +4321,9 @@ Vector2i PlanarReflectorCPP::apply_lod_to_size(Vector2i target_size, Camera3D *a
     double distance = get_global_transform().get_origin().distance_to(active_cam->get_global_transform().get_origin());
     
     // Cache LOD calculations when distance hasn't changed much
-    // Reduces CPU overhead by avoiding repeated calculations
-    if (Math::abs(distance - last_distance_check) > 1.0) {
-        double lod_factor = 1.0;  // Start with full quality
-        
-        if (distance > lod_distance_near) {
-            // Calculate interpolation factor between near and far distances
-            double lerp_factor = Math::clamp((distance - lod_distance_near) / (lod_distance_far - lod_distance_near), 0.0, 1.0);
-            // Interpolate between full quality (1.0) and reduced quality
-            lod_factor = Math::lerp(1.0, lod_resolution_multiplier, lerp_factor);
-        }
-        
-        cached_lod_factor = lod_factor;
+    // Reduces CPU overhead by avoiding repeated calculations (negative = cache reset)
+    if (last_distance_check < 0.0 || Math::abs(distance - last_distance_check) > 1.0) {
+        cached_lod_factor = compute_lod_factor(distance);
         last_distance_check = distance;
     }
     
@@ -779,12 +4331,83 @@ Vector2i PlanarReflectorCPP::apply_lod_to_size(Vector2i target_size, Camera3D *a
     Vector2i result_size = Vector2i((double)target_size.x * cached_lod_factor, (double)target_size.y * cached_lod_factor);
     
     // Enforce minimum resolution to prevent degenerate cases
-    result_size.x = Math::max(result_size.x, 128);
-    result_size.y = Math::max(result_size.y, 128);
+    result_size.x = Math::max(result_size.x, get_min_reflection_size());
+    result_size.y = Math::max(result_size.y, get_min_reflection_size());
     
     return result_size;
 }
 
+/**
+ * @brief Distance-based resolution factor between 1.0 (near) and lod_resolution_multiplier (far)
+ */
+double PlanarReflectorCPP::compute_lod_factor(double distance) const
+{
+    // Shared with the offline replay tool
+    return ReflectionScheduling::lod_factor(distance, lod_distance_near, lod_distance_far, lod_resolution_multiplier);
+}
+
+/**
+ * @brief Scales the reflection resolution down in proportion to the surface blur
+ * 
+ * A rough surface blurs the reflection over a kernel several texels wide, so
+ * rendering it at full resolution wastes fill rate. Roughness 0 keeps the full
+ * size, roughness 1 renders at roughness_min_resolution_scale (1/8 by default).
+ * 
+ * @param target_size Size after screen matching and distance LOD
+ * @return Vector2i Size after the roughness cap is applied
+ */
+Vector2i PlanarReflectorCPP::apply_roughness_to_size(Vector2i target_size)
+{
+    double roughness = get_effective_roughness();
+    if (roughness <= 0.0) {
+        return target_size;  // Sharp mirror - keep full resolution
+    }
+
+    // Blur kernel grows from 1 texel (sharp) to 1/min_scale texels (fully rough)
+    double roughness_factor = ReflectionScheduling::roughness_factor(roughness, roughness_min_resolution_scale);
+
+    Vector2i result_size = Vector2i((double)target_size.x * roughness_factor, (double)target_size.y * roughness_factor);
+
+    // Same minimum as the LOD system to prevent degenerate cases
+    result_size.x = Math::max(result_size.x, get_min_reflection_size());
+    result_size.y = Math::max(result_size.y, get_min_reflection_size());
+
+    return result_size;
+}
+
+/**
+ * @brief Returns the roughness driving resolution - material value wins when auto-detected
+ */
+double PlanarReflectorCPP::get_effective_roughness() const
+{
+    if (auto_detect_roughness && detected_roughness >= 0.0) {
+        return detected_roughness;
+    }
+    return surface_roughness;
+}
+
+/**
+ * @brief Reads the "reflection_roughness" uniform from the reflector material
+ * 
+ * When the value changes the next viewport size check is forced so the
+ * resolution follows artist tweaks without waiting for the periodic check.
+ * 
+ * @param material The ShaderMaterial displaying the reflection
+ */
+void PlanarReflectorCPP::detect_material_roughness(ShaderMaterial *material)
+{
+    Variant value = material->get_shader_parameter("reflection_roughness");
+    double roughness = -1.0;
+    if (value.get_type() == Variant::FLOAT || value.get_type() == Variant::INT) {
+        roughness = Math::clamp((double)value, 0.0, 1.0);
+    }
+
+    if (!Math::is_equal_approx(roughness, detected_roughness)) {
+        detected_roughness = roughness;
+        last_viewport_check_frame = frame_counter - viewport_check_frequency;  // Resize on next check
+    }
+}
+
 /**
  * @brief Sets the editor camera reference for editor mode operation
  * 
@@ -798,7 +4421,15 @@ void PlanarReflectorCPP::set_editor_camera(Camera3D *viewport_camera)
 {
     // UtilityFunctions::print("[PlanarReflectorCPP2] set_editor_camera called");
 
-    editor_camera = viewport_camera;
+    // A different editor camera is a cut - refresh everything at once
+    if (editor_camera != viewport_camera) {
+        editor_camera = viewport_camera;
+        camera_cut_pending = true;
+        if (detect_camera_cut()) {
+            force_reflection_refresh();
+            return;
+        }
+    }
     
     // Immediately update reflection system with new camera
     update_reflect_viewport_size();      // Match viewport to editor size
@@ -841,9 +4472,37 @@ bool PlanarReflectorCPP::is_planar_reflector_active()
  */
 void PlanarReflectorCPP::_exit_tree()
 {
-    // CRITICAL: Clear shader references FIRST to prevent crashes
+    // Hand player cameras and this mesh their own layers back before the views go
+    clear_split_screen_cameras();
+
+    // CRITICAL: Clear shader references before anything else to prevent crashes
     // This must happen before Godot frees the viewport and camera nodes
     clear_shader_texture_references();
+
+    // Stop content tracking callbacks from the scene tree
+    release_content_tracker();
+
+    // Flush and close any running trace
+    stop_trace_capture();
+
+    // Overlay nodes are recreated on the next rate update if still enabled
+    remove_cost_overlay();
+
+    // The column mask lives in this world's scenario - recreated on the next phase
+    free_interleave_mask();
+
+    // Out of the tree means out of the VRAM accounting
+    registered_reflectors.erase(this);
+
+    // Last reflector gone - stop the wake-up scheduler, drop the occluder list and derived environments
+    if (registered_reflectors.is_empty()) {
+        disconnect_event_scheduler(get_tree());
+        occluder_node_ids.clear();
+        occluder_face_cache.clear();
+        occluder_list_frame = 0;
+        release_derived_environments();
+    }
+    process_sleeping = false;
 }
 
 /**
@@ -889,6 +4548,31 @@ void PlanarReflectorCPP::_bind_methods()
     ClassDB::bind_method(D_METHOD("get_auto_detect_camera_mode"), &PlanarReflectorCPP::get_auto_detect_camera_mode);
     ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_detect_camera_mode", PROPERTY_HINT_NONE, "Automatically match the main camera's projection mode (perspective/orthogonal)"), "set_auto_detect_camera_mode", "get_auto_detect_camera_mode");
 
+    // Split-screen update budget - Extra views rendered per frame
+    ClassDB::bind_method(D_METHOD("set_split_screen_updates_per_frame", "p_updates"), &PlanarReflectorCPP::set_split_screen_updates_per_frame);
+    ClassDB::bind_method(D_METHOD("get_split_screen_updates_per_frame"), &PlanarReflectorCPP::get_split_screen_updates_per_frame);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "split_screen_updates_per_frame", PROPERTY_HINT_RANGE, "1,3,1", PROPERTY_USAGE_DEFAULT, "How many split-screen views (added with add_split_screen_camera) are re-rendered per frame, round-robin"), "set_split_screen_updates_per_frame", "get_split_screen_updates_per_frame");
+
+    // Split-screen pixel budget - Combined size cap of the extra views
+    ClassDB::bind_method(D_METHOD("set_split_screen_pixel_budget", "p_pixels"), &PlanarReflectorCPP::set_split_screen_pixel_budget);
+    ClassDB::bind_method(D_METHOD("get_split_screen_pixel_budget"), &PlanarReflectorCPP::get_split_screen_pixel_budget);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "split_screen_pixel_budget", PROPERTY_HINT_RANGE, "0,16777216,1", PROPERTY_USAGE_DEFAULT, "Maximum combined pixel count of all split-screen view targets. Views are scaled down uniformly when exceeded. 0 = unlimited"), "set_split_screen_pixel_budget", "get_split_screen_pixel_budget");
+
+    // Split-screen layers - One render layer per player selects their view
+    ClassDB::bind_method(D_METHOD("set_split_screen_first_layer", "p_layer"), &PlanarReflectorCPP::set_split_screen_first_layer);
+    ClassDB::bind_method(D_METHOD("get_split_screen_first_layer"), &PlanarReflectorCPP::get_split_screen_first_layer);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "split_screen_first_layer", PROPERTY_HINT_RANGE, "1,17,1", PROPERTY_USAGE_DEFAULT, "First of four render layers reserved for split-screen. With extra cameras, each player sees a copy of this mesh on their own layer whose reflection_view_index instance uniform selects their texture. Player cameras' cull masks are adjusted automatically"), "set_split_screen_first_layer", "get_split_screen_first_layer");
+
+    // Orthogonal scroll cache - Pans reuse an oversized render instead of re-rendering
+    ClassDB::bind_method(D_METHOD("set_ortho_scroll_cache", "p_enable"), &PlanarReflectorCPP::set_ortho_scroll_cache);
+    ClassDB::bind_method(D_METHOD("get_ortho_scroll_cache"), &PlanarReflectorCPP::get_ortho_scroll_cache);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "ortho_scroll_cache", PROPERTY_HINT_NONE, "Orthogonal cameras only: render an oversized reflection and scroll its UVs while the camera pans. Re-renders when the view leaves the margin"), "set_ortho_scroll_cache", "get_ortho_scroll_cache");
+
+    // Margin rendered around the orthogonal view
+    ClassDB::bind_method(D_METHOD("set_ortho_cache_margin", "p_margin"), &PlanarReflectorCPP::set_ortho_cache_margin);
+    ClassDB::bind_method(D_METHOD("get_ortho_cache_margin"), &PlanarReflectorCPP::get_ortho_cache_margin);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "ortho_cache_margin", PROPERTY_HINT_RANGE, "0.05,1.0,0.05", PROPERTY_USAGE_DEFAULT, "Extra area rendered on each side as a fraction of the view. Larger margins re-render less often but cost more pixels"), "set_ortho_cache_margin", "get_ortho_cache_margin");
+
     // === REFLECTION LAYERS AND ENVIRONMENT GROUP ===
     ADD_GROUP("Reflection Layers and Environment", "");
     
@@ -907,6 +4591,15 @@ void PlanarReflectorCPP::_bind_methods()
     ClassDB::bind_method(D_METHOD("get_custom_environment"), &PlanarReflectorCPP::get_custom_environment);
     ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "custom_environment", PROPERTY_HINT_RESOURCE_TYPE, "Environment", PROPERTY_USAGE_DEFAULT, "Custom Environment for reflection rendering (skybox, fog, lighting)"), "set_custom_environment", "get_custom_environment");
 
+    // Derived environment - Lightweight copy of the main camera / world environment
+    ClassDB::bind_method(D_METHOD("set_derive_environment_from_camera", "p_enable"), &PlanarReflectorCPP::set_derive_environment_from_camera);
+    ClassDB::bind_method(D_METHOD("get_derive_environment_from_camera"), &PlanarReflectorCPP::get_derive_environment_from_camera);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "derive_environment_from_camera", PROPERTY_HINT_NONE, "Build the reflection environment from the main camera or WorldEnvironment (sky, ambient, tonemap, fog) with expensive effects stripped. Ignored while use_custom_environment is on"), "set_derive_environment_from_camera", "get_derive_environment_from_camera");
+
+    ClassDB::bind_method(D_METHOD("set_reflection_environment_tier", "p_tier"), &PlanarReflectorCPP::set_reflection_environment_tier);
+    ClassDB::bind_method(D_METHOD("get_reflection_environment_tier"), &PlanarReflectorCPP::get_reflection_environment_tier);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "reflection_environment_tier", PROPERTY_HINT_ENUM, "Low,Medium,High", PROPERTY_USAGE_DEFAULT, "Features kept in the derived environment. High keeps SSAO, volumetric fog and glow; Medium keeps glow; Low keeps only sky, ambient, tonemap and fog"), "set_reflection_environment_tier", "get_reflection_environment_tier");
+
     // === REFLECTION COMPOSITOR EFFECTS GROUP ===
     ADD_GROUP("Reflection Compositor Effects", "");
     
@@ -971,6 +4664,21 @@ void PlanarReflectorCPP::_bind_methods()
     ClassDB::bind_method(D_METHOD("get_update_frequency"), &PlanarReflectorCPP::get_update_frequency);
     ADD_PROPERTY(PropertyInfo(Variant::INT, "update_frequency", PROPERTY_HINT_RANGE, "1,10,1", PROPERTY_USAGE_DEFAULT, "Update reflections every N frames. Higher = better performance but choppier reflections"), "set_update_frequency", "get_update_frequency");
 
+    // Event-driven processing - Idle reflectors cost nothing per frame
+    ClassDB::bind_method(D_METHOD("set_event_driven", "p_enable"), &PlanarReflectorCPP::set_event_driven);
+    ClassDB::bind_method(D_METHOD("get_event_driven"), &PlanarReflectorCPP::get_event_driven);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "event_driven", PROPERTY_HINT_NONE, "Switch off per-frame processing while nothing changes. Camera movement, moving the reflector, property changes and a once-per-second heartbeat wake it up"), "set_event_driven", "get_event_driven");
+
+    // Interleaved rendering - Half the columns per frame, reconstructed in the shader
+    ClassDB::bind_method(D_METHOD("set_interleaved_rendering", "p_enable"), &PlanarReflectorCPP::set_interleaved_rendering);
+    ClassDB::bind_method(D_METHOD("get_interleaved_rendering"), &PlanarReflectorCPP::get_interleaved_rendering);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "interleaved_rendering", PROPERTY_HINT_NONE, "Render alternate columns of the reflection on alternate frames. A near-plane mask keeps the other columns from being shaded, halving fill cost; the shader recombines the two full-size phase targets by column. Best with update_frequency = 1"), "set_interleaved_rendering", "get_interleaved_rendering");
+
+    // Double-buffered targets - Sample the last completed render while the next one is drawn
+    ClassDB::bind_method(D_METHOD("set_double_buffered_reflections", "p_enable"), &PlanarReflectorCPP::set_double_buffered_reflections);
+    ClassDB::bind_method(D_METHOD("get_double_buffered_reflections"), &PlanarReflectorCPP::get_double_buffered_reflections);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "double_buffered_reflections", PROPERTY_HINT_NONE, "Render each update into a back buffer while the material samples the last completed one, then swap. Removes the same-frame dependency between the reflection pass and the main pass at one frame of extra latency. Renders only on updates, so pair it with update_frequency > 1"), "set_double_buffered_reflections", "get_double_buffered_reflections");
+
     // Level-of-detail system toggle
     ClassDB::bind_method(D_METHOD("set_use_lod", "p_use_lod"), &PlanarReflectorCPP::set_use_lod);
     ClassDB::bind_method(D_METHOD("get_use_lod"), &PlanarReflectorCPP::get_use_lod);
@@ -991,6 +4699,124 @@ void PlanarReflectorCPP::_bind_methods()
     ClassDB::bind_method(D_METHOD("get_lod_resolution_multiplier"), &PlanarReflectorCPP::get_lod_resolution_multiplier);
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_resolution_multiplier", PROPERTY_HINT_RANGE, "0.1,1.0,0.01", PROPERTY_USAGE_DEFAULT, "Resolution multiplier for distant reflections. 0.5 = half resolution, 0.25 = quarter resolution"), "set_lod_resolution_multiplier", "get_lod_resolution_multiplier");
 
+    // Minimum reflection size - Floor for LOD and roughness scaling
+    ClassDB::bind_method(D_METHOD("set_min_reflection_size", "p_size"), &PlanarReflectorCPP::set_min_reflection_size);
+    ClassDB::bind_method(D_METHOD("get_min_reflection_size"), &PlanarReflectorCPP::get_min_reflection_size);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "min_reflection_size", PROPERTY_HINT_RANGE, "16,512,16", PROPERTY_USAGE_DEFAULT, "Smallest reflection target edge in pixels. Lower it for small or distant reflectors (wing mirrors, puddles) so LOD can shrink them further"), "set_min_reflection_size", "get_min_reflection_size");
+
+    // Instance uniforms - Per-reflector state without a per-reflector material
+    ClassDB::bind_method(D_METHOD("set_use_instance_uniforms", "p_enable"), &PlanarReflectorCPP::set_use_instance_uniforms);
+    ClassDB::bind_method(D_METHOD("get_use_instance_uniforms"), &PlanarReflectorCPP::get_use_instance_uniforms);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_instance_uniforms", PROPERTY_HINT_NONE, "Write plane, offsets, projection flags and other non-texture reflection state as instance uniforms, so reflectors can share one material (declare them as 'instance uniform' in the shader). Textures stay material parameters, so reflectors sharing a material sample the same reflection"), "set_use_instance_uniforms", "get_use_instance_uniforms");
+
+    // Empty-mirror fast path - Skip rendering when nothing is reflected
+    ClassDB::bind_method(D_METHOD("set_skip_empty_reflections", "p_enable"), &PlanarReflectorCPP::set_skip_empty_reflections);
+    ClassDB::bind_method(D_METHOD("get_skip_empty_reflections"), &PlanarReflectorCPP::get_skip_empty_reflections);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "skip_empty_reflections", PROPERTY_HINT_NONE, "Skip the reflection render while no geometry on reflection_layers is inside the mirrored view. The shader then shows the environment only (reflection_environment_only)"), "set_skip_empty_reflections", "get_skip_empty_reflections");
+
+    // Occlusion culling - Skip rendering while the reflector is hidden behind occluders
+    ClassDB::bind_method(D_METHOD("set_occlusion_culling", "p_enable"), &PlanarReflectorCPP::set_occlusion_culling);
+    ClassDB::bind_method(D_METHOD("get_occlusion_culling"), &PlanarReflectorCPP::get_occlusion_culling);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "occlusion_culling", PROPERTY_HINT_NONE, "Stop rendering while the reflector is hidden behind OccluderInstance3D nodes or MeshInstance3D nodes in the 'reflection_occluders' group, tested against a small CPU depth buffer. Rendering resumes slightly before the reflector is revealed"), "set_occlusion_culling", "get_occlusion_culling");
+
+    // Reflection clip range - Near plane fitted to the mirror, optional draw distance
+    ClassDB::bind_method(D_METHOD("set_tight_reflection_clip", "p_enable"), &PlanarReflectorCPP::set_tight_reflection_clip);
+    ClassDB::bind_method(D_METHOD("get_tight_reflection_clip"), &PlanarReflectorCPP::get_tight_reflection_clip);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "tight_reflection_clip", PROPERTY_HINT_NONE, "Move the reflection camera's near plane up to the mirror so geometry behind it is never drawn. Disables the intersect compositor pass when it becomes redundant"), "set_tight_reflection_clip", "get_tight_reflection_clip");
+
+    ClassDB::bind_method(D_METHOD("set_reflection_draw_distance", "p_distance"), &PlanarReflectorCPP::set_reflection_draw_distance);
+    ClassDB::bind_method(D_METHOD("get_reflection_draw_distance"), &PlanarReflectorCPP::get_reflection_draw_distance);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "reflection_draw_distance", PROPERTY_HINT_RANGE, "0.0,4000.0,1.0,or_greater", PROPERTY_USAGE_DEFAULT, "How far beyond the mirror the reflection renders. 0 = same far plane as the source camera (requires tight_reflection_clip)"), "set_reflection_draw_distance", "get_reflection_draw_distance");
+
+    // Cost overlay - Heatmap tint, label and shared-target outline
+    ClassDB::bind_method(D_METHOD("set_show_cost_overlay", "p_enable"), &PlanarReflectorCPP::set_show_cost_overlay);
+    ClassDB::bind_method(D_METHOD("get_show_cost_overlay"), &PlanarReflectorCPP::get_show_cost_overlay);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "show_cost_overlay", PROPERTY_HINT_NONE, "Debug: tint the reflector by render cost and label it with resolution, LOD factor and skip reason. Works in the editor and at runtime"), "set_show_cost_overlay", "get_show_cost_overlay");
+
+    ClassDB::bind_method(D_METHOD("set_cost_overlay_metric", "p_metric"), &PlanarReflectorCPP::set_cost_overlay_metric);
+    ClassDB::bind_method(D_METHOD("get_cost_overlay_metric"), &PlanarReflectorCPP::get_cost_overlay_metric);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "cost_overlay_metric", PROPERTY_HINT_ENUM, "Megapixels per Second,Update Rate", PROPERTY_USAGE_DEFAULT, "What the cost overlay tint shows. Full red = 100 MP/s or 60 renders/s"), "set_cost_overlay_metric", "get_cost_overlay_metric");
+
+    // Camera cut thresholds - Jumps beyond these bypass update throttling
+    ClassDB::bind_method(D_METHOD("set_camera_cut_distance", "p_distance"), &PlanarReflectorCPP::set_camera_cut_distance);
+    ClassDB::bind_method(D_METHOD("get_camera_cut_distance"), &PlanarReflectorCPP::get_camera_cut_distance);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "camera_cut_distance", PROPERTY_HINT_RANGE, "0.0,100.0,0.1", PROPERTY_USAGE_DEFAULT, "Camera movement in a single frame that counts as a cut and forces an immediate reflection refresh. 0 = disabled"), "set_camera_cut_distance", "get_camera_cut_distance");
+
+    ClassDB::bind_method(D_METHOD("set_camera_cut_angle", "p_degrees"), &PlanarReflectorCPP::set_camera_cut_angle);
+    ClassDB::bind_method(D_METHOD("get_camera_cut_angle"), &PlanarReflectorCPP::get_camera_cut_angle);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "camera_cut_angle", PROPERTY_HINT_RANGE, "0.0,180.0,1.0,degrees", PROPERTY_USAGE_DEFAULT, "Camera rotation in a single frame that counts as a cut and forces an immediate reflection refresh. 0 = disabled"), "set_camera_cut_angle", "get_camera_cut_angle");
+
+    // Predictive extrapolation - Throttled updates mirror where the camera is going to be
+    ClassDB::bind_method(D_METHOD("set_predictive_camera", "p_enable"), &PlanarReflectorCPP::set_predictive_camera);
+    ClassDB::bind_method(D_METHOD("get_predictive_camera"), &PlanarReflectorCPP::get_predictive_camera);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "predictive_camera", PROPERTY_HINT_NONE, "With update_frequency > 1, mirror the camera pose extrapolated to the middle of the interval each render is shown for, using the tracked camera velocity. Reduces lag when reflections update every few frames"), "set_predictive_camera", "get_predictive_camera");
+
+    ClassDB::bind_method(D_METHOD("set_prediction_overscan", "p_fraction"), &PlanarReflectorCPP::set_prediction_overscan);
+    ClassDB::bind_method(D_METHOD("get_prediction_overscan"), &PlanarReflectorCPP::get_prediction_overscan);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "prediction_overscan", PROPERTY_HINT_RANGE, "0.0,0.5,0.01", PROPERTY_USAGE_DEFAULT, "Extra field of view rendered around the predicted pose, as a fraction. Gives the shader room to shift when the prediction misses"), "set_prediction_overscan", "get_prediction_overscan");
+
+    // Surface roughness - Blurred reflections render at reduced resolution
+    ClassDB::bind_method(D_METHOD("set_surface_roughness", "p_roughness"), &PlanarReflectorCPP::set_surface_roughness);
+    ClassDB::bind_method(D_METHOD("get_surface_roughness"), &PlanarReflectorCPP::get_surface_roughness);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "surface_roughness", PROPERTY_HINT_RANGE, "0.0,1.0,0.01", PROPERTY_USAGE_DEFAULT, "How much the shader blurs the reflection. 0 = sharp mirror (full resolution), 1 = fully rough (minimum resolution scale)"), "set_surface_roughness", "get_surface_roughness");
+
+    // Roughness auto-detection from the reflector ShaderMaterial
+    ClassDB::bind_method(D_METHOD("set_auto_detect_roughness", "p_auto_detect"), &PlanarReflectorCPP::set_auto_detect_roughness);
+    ClassDB::bind_method(D_METHOD("get_auto_detect_roughness"), &PlanarReflectorCPP::get_auto_detect_roughness);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_detect_roughness", PROPERTY_HINT_NONE, "Read the 'reflection_roughness' shader uniform from the material and use it instead of surface_roughness"), "set_auto_detect_roughness", "get_auto_detect_roughness");
+
+    // Lowest resolution scale reached by fully rough surfaces
+    ClassDB::bind_method(D_METHOD("set_roughness_min_resolution_scale", "p_scale"), &PlanarReflectorCPP::set_roughness_min_resolution_scale);
+    ClassDB::bind_method(D_METHOD("get_roughness_min_resolution_scale"), &PlanarReflectorCPP::get_roughness_min_resolution_scale);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "roughness_min_resolution_scale", PROPERTY_HINT_RANGE, "0.05,1.0,0.005", PROPERTY_USAGE_DEFAULT, "Resolution scale used at roughness 1.0. 0.25 = quarter resolution, 0.125 = eighth resolution"), "set_roughness_min_resolution_scale", "get_roughness_min_resolution_scale");
+
+    // Static until changed - Only re-render when the view or tracked content changes
+    ClassDB::bind_method(D_METHOD("set_static_until_changed", "p_enable"), &PlanarReflectorCPP::set_static_until_changed);
+    ClassDB::bind_method(D_METHOD("get_static_until_changed"), &PlanarReflectorCPP::get_static_until_changed);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "static_until_changed", PROPERTY_HINT_NONE, "Re-render only when the mirrored view, a tracked node inside the reflection or a light changes. Ideal for static interiors"), "set_static_until_changed", "get_static_until_changed");
+
+    // Automatic tracking of scene content
+    ClassDB::bind_method(D_METHOD("set_auto_track_reflected_nodes", "p_enable"), &PlanarReflectorCPP::set_auto_track_reflected_nodes);
+    ClassDB::bind_method(D_METHOD("get_auto_track_reflected_nodes"), &PlanarReflectorCPP::get_auto_track_reflected_nodes);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_track_reflected_nodes", PROPERTY_HINT_NONE, "Automatically track geometry on reflection_layers and all lights. Disable to register nodes manually with track_reflected_node()"), "set_auto_track_reflected_nodes", "get_auto_track_reflected_nodes");
+
+    // Maximum time a static reflection may go without re-rendering
+    ClassDB::bind_method(D_METHOD("set_max_staleness", "p_seconds"), &PlanarReflectorCPP::set_max_staleness);
+    ClassDB::bind_method(D_METHOD("get_max_staleness"), &PlanarReflectorCPP::get_max_staleness);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_staleness", PROPERTY_HINT_RANGE, "0.0,60.0,0.1,suffix:s", PROPERTY_USAGE_DEFAULT, "Static mode re-renders at least this often to catch untracked changes (animated materials, particles). 0 = never"), "set_max_staleness", "get_max_staleness");
+
+    // Pose cache - Returning to a cached viewpoint swaps in the earlier render
+    ClassDB::bind_method(D_METHOD("set_pose_cache", "p_enable"), &PlanarReflectorCPP::set_pose_cache);
+    ClassDB::bind_method(D_METHOD("get_pose_cache"), &PlanarReflectorCPP::get_pose_cache);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "pose_cache", PROPERTY_HINT_NONE, "Static mode only: keep finished renders per quantized camera pose and reflector transform. Cutting back to a cached pose shows the earlier render instead of re-rendering. Content changes clear the cache"), "set_pose_cache", "get_pose_cache");
+
+    ClassDB::bind_method(D_METHOD("set_pose_cache_memory_mb", "p_megabytes"), &PlanarReflectorCPP::set_pose_cache_memory_mb);
+    ClassDB::bind_method(D_METHOD("get_pose_cache_memory_mb"), &PlanarReflectorCPP::get_pose_cache_memory_mb);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "pose_cache_memory_mb", PROPERTY_HINT_RANGE, "1,2048,1,suffix:MB", PROPERTY_USAGE_DEFAULT, "Memory cap for parked pose cache renders. Least recently used poses are dropped first"), "set_pose_cache_memory_mb", "get_pose_cache_memory_mb");
+
+    // Budget priority - Higher priority reflectors are evicted last
+    ClassDB::bind_method(D_METHOD("set_reflection_priority", "p_priority"), &PlanarReflectorCPP::set_reflection_priority);
+    ClassDB::bind_method(D_METHOD("get_reflection_priority"), &PlanarReflectorCPP::get_reflection_priority);
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "reflection_priority", PROPERTY_HINT_RANGE, "0,100,1", PROPERTY_USAGE_DEFAULT, "Importance under the global VRAM budget. When over budget, invisible and low priority reflectors release their targets first"), "set_reflection_priority", "get_reflection_priority");
+
+    // Lazy allocation - Create the reflection rig only once the reflector is seen
+    ClassDB::bind_method(D_METHOD("set_lazy_rig_allocation", "p_lazy"), &PlanarReflectorCPP::set_lazy_rig_allocation);
+    ClassDB::bind_method(D_METHOD("get_lazy_rig_allocation"), &PlanarReflectorCPP::get_lazy_rig_allocation);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lazy_rig_allocation", PROPERTY_HINT_NONE, "Defer creating the reflection viewport and camera until the reflector first becomes visible to the active camera"), "set_lazy_rig_allocation", "get_lazy_rig_allocation");
+
+    // Release timeout - Free the rig after being invisible this long
+    ClassDB::bind_method(D_METHOD("set_rig_release_timeout", "p_seconds"), &PlanarReflectorCPP::set_rig_release_timeout);
+    ClassDB::bind_method(D_METHOD("get_rig_release_timeout"), &PlanarReflectorCPP::get_rig_release_timeout);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "rig_release_timeout", PROPERTY_HINT_RANGE, "0.0,300.0,0.5,suffix:s", PROPERTY_USAGE_DEFAULT, "Release the reflection viewport after the reflector has been invisible for this long. It is recreated when seen again. 0 = never release"), "set_rig_release_timeout", "get_rig_release_timeout");
+
+    // Prewarm - Compile reflection pipelines while loading
+    ClassDB::bind_method(D_METHOD("set_prewarm_on_ready", "p_enable"), &PlanarReflectorCPP::set_prewarm_on_ready);
+    ClassDB::bind_method(D_METHOD("get_prewarm_on_ready"), &PlanarReflectorCPP::get_prewarm_on_ready);
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "prewarm_on_ready", PROPERTY_HINT_NONE, "Render the reflection once at a tiny size right after setup, with its environment and compositor, so shader pipelines compile during loading instead of when the reflector is first seen. Also builds lazy rigs"), "set_prewarm_on_ready", "get_prewarm_on_ready");
+    ClassDB::bind_method(D_METHOD("prewarm_reflection"), &PlanarReflectorCPP::prewarm_reflection);
+    ClassDB::bind_method(D_METHOD("is_prewarming"), &PlanarReflectorCPP::is_prewarming);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("prewarm_all_reflectors"), &PlanarReflectorCPP::prewarm_all_reflectors);
+
     // === UTILITY METHODS FOR EDITOR INTEGRATION ===
     // These methods are critical for the editor plugin to function properly
     
@@ -998,6 +4824,74 @@ void PlanarReflectorCPP::_bind_methods()
     ClassDB::bind_method(D_METHOD("set_editor_camera", "viewport_camera"), &PlanarReflectorCPP::set_editor_camera);
     ClassDB::bind_method(D_METHOD("get_active_camera"), &PlanarReflectorCPP::get_active_camera);
     ClassDB::bind_method(D_METHOD("is_planar_reflector_active"), &PlanarReflectorCPP::is_planar_reflector_active);
+    ClassDB::bind_method(D_METHOD("invalidate_reflection_cache"), &PlanarReflectorCPP::invalidate_reflection_cache);
+    ClassDB::bind_method(D_METHOD("force_reflection_refresh"), &PlanarReflectorCPP::force_reflection_refresh);
+
+    // Event-driven state - True while _process is switched off
+    ClassDB::bind_method(D_METHOD("is_process_sleeping"), &PlanarReflectorCPP::is_process_sleeping);
+
+    // Cost overlay - Render cost queries and global toggle
+    ClassDB::bind_method(D_METHOD("get_skip_reason"), &PlanarReflectorCPP::get_skip_reason);
+    ClassDB::bind_method(D_METHOD("get_rendered_megapixels_per_second"), &PlanarReflectorCPP::get_rendered_megapixels_per_second);
+    ClassDB::bind_method(D_METHOD("get_renders_per_second"), &PlanarReflectorCPP::get_renders_per_second);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("set_cost_overlay_for_all", "p_enable"), &PlanarReflectorCPP::set_cost_overlay_for_all);
+
+    // Trace capture - Binary per-frame records for tools/reflection_replay
+    ClassDB::bind_method(D_METHOD("start_trace_capture", "p_path"), &PlanarReflectorCPP::start_trace_capture);
+    ClassDB::bind_method(D_METHOD("stop_trace_capture"), &PlanarReflectorCPP::stop_trace_capture);
+    ClassDB::bind_method(D_METHOD("is_trace_capturing"), &PlanarReflectorCPP::is_trace_capturing);
+
+    // Diagnostics - Rate-limited error counters and recent event log (process-wide)
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("get_diagnostic_counts"), &PlanarReflectorCPP::get_diagnostic_counts);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("get_recent_diagnostics", "p_max_events"), &PlanarReflectorCPP::get_recent_diagnostics);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("clear_diagnostics"), &PlanarReflectorCPP::clear_diagnostics);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("set_diagnostics_print_enabled", "p_enabled"), &PlanarReflectorCPP::set_diagnostics_print_enabled);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("get_diagnostics_print_enabled"), &PlanarReflectorCPP::get_diagnostics_print_enabled);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("set_diagnostics_print_interval", "p_seconds"), &PlanarReflectorCPP::set_diagnostics_print_interval);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("get_diagnostics_print_interval"), &PlanarReflectorCPP::get_diagnostics_print_interval);
+
+    // Property batching - Bulk property changes with a single recompute
+    ClassDB::bind_method(D_METHOD("begin_batch"), &PlanarReflectorCPP::begin_batch);
+    ClassDB::bind_method(D_METHOD("commit_batch"), &PlanarReflectorCPP::commit_batch);
+    ClassDB::bind_method(D_METHOD("is_batching"), &PlanarReflectorCPP::is_batching);
+    ClassDB::bind_method(D_METHOD("apply_settings", "p_settings"), &PlanarReflectorCPP::apply_settings);
+
+    // Split-screen cameras - One mirrored view and target per extra player
+    ClassDB::bind_method(D_METHOD("add_split_screen_camera", "p_camera"), &PlanarReflectorCPP::add_split_screen_camera);
+    ClassDB::bind_method(D_METHOD("remove_split_screen_camera", "p_camera"), &PlanarReflectorCPP::remove_split_screen_camera);
+    ClassDB::bind_method(D_METHOD("clear_split_screen_cameras"), &PlanarReflectorCPP::clear_split_screen_cameras);
+    ClassDB::bind_method(D_METHOD("get_split_screen_cameras"), &PlanarReflectorCPP::get_split_screen_cameras);
+
+    // Content tracking registration - For static reflections
+    ClassDB::bind_method(D_METHOD("track_reflected_node", "p_node"), &PlanarReflectorCPP::track_reflected_node);
+    ClassDB::bind_method(D_METHOD("untrack_reflected_node", "p_node"), &PlanarReflectorCPP::untrack_reflected_node);
+    ClassDB::bind_method(D_METHOD("clear_tracked_nodes"), &PlanarReflectorCPP::clear_tracked_nodes);
+    ClassDB::bind_method(D_METHOD("get_tracked_node_count"), &PlanarReflectorCPP::get_tracked_node_count);
+
+    // VRAM accounting - Per reflector and process-wide budget
+    ClassDB::bind_method(D_METHOD("get_estimated_vram_bytes"), &PlanarReflectorCPP::get_estimated_vram_bytes);
+    ClassDB::bind_method(D_METHOD("get_vram_usage_breakdown"), &PlanarReflectorCPP::get_vram_usage_breakdown);
+    ClassDB::bind_method(D_METHOD("is_budget_evicted"), &PlanarReflectorCPP::is_budget_evicted);
+
+    // Rig lifetime - Manual release and allocation state
+    ClassDB::bind_method(D_METHOD("release_reflection_rig"), &PlanarReflectorCPP::release_reflection_rig);
+    ClassDB::bind_method(D_METHOD("is_reflection_rig_allocated"), &PlanarReflectorCPP::is_reflection_rig_allocated);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("set_reflection_vram_budget", "p_bytes"), &PlanarReflectorCPP::set_reflection_vram_budget);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("get_reflection_vram_budget"), &PlanarReflectorCPP::get_reflection_vram_budget);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("get_total_reflection_vram"), &PlanarReflectorCPP::get_total_reflection_vram);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("get_reflection_vram_report"), &PlanarReflectorCPP::get_reflection_vram_report);
+
+    // Empty-mirror state - True while only the environment is reflected
+    ClassDB::bind_method(D_METHOD("is_reflection_empty"), &PlanarReflectorCPP::is_reflection_empty);
+
+    // Occlusion state - True while rendering is skipped behind occluders
+    ClassDB::bind_method(D_METHOD("is_reflection_occluded"), &PlanarReflectorCPP::is_reflection_occluded);
+
+    // Baked visibility - Process-wide potentially-visible sets per camera cell
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("set_reflector_visibility_set", "p_set"), &PlanarReflectorCPP::set_reflector_visibility_set);
+    ClassDB::bind_static_method("PlanarReflectorCPP", D_METHOD("get_reflector_visibility_set"), &PlanarReflectorCPP::get_reflector_visibility_set);
+    ClassDB::bind_method(D_METHOD("is_pvs_culled"), &PlanarReflectorCPP::is_pvs_culled);
+
     
     // Manual update methods - For debugging and plugin integration
     ClassDB::bind_method(D_METHOD("update_reflect_viewport_size"), &PlanarReflectorCPP::update_reflect_viewport_size);
@@ -1025,7 +4919,13 @@ void PlanarReflectorCPP::_bind_methods()
 /**
  @brief Sets the active state of the reflection system
  */
-void PlanarReflectorCPP::set_is_active(const bool p_active) { is_active = p_active; }
+void PlanarReflectorCPP::set_is_active(const bool p_active)
+{
+    is_active = p_active;
+    if (is_active) {
+        wake_reflector();  // Inactive reflectors sleep with processing off
+    }
+}
 
 /**
  * @brief Gets the current active state
@@ -1037,6 +4937,7 @@ bool PlanarReflectorCPP::get_is_active() const { return is_active; }
  */
 void PlanarReflectorCPP::set_main_camera(Camera3D *p_camera) 
 {
+    Camera3D *previous_camera = main_camera;
     main_camera = Object::cast_to<Camera3D>(p_camera);
     
     // Update reflection camera if both cameras exist
@@ -1046,7 +4947,17 @@ void PlanarReflectorCPP::set_main_camera(Camera3D *p_camera)
         reflect_camera->set_doppler_tracking(main_camera->get_doppler_tracking());
         
         // Refresh environment to ensure consistency
-        setup_reflection_environment();
+        if (!defer_to_batch(BATCH_DIRTY_ENVIRONMENT)) {
+            setup_reflection_environment();
+        }
+    }
+
+    // Switching cameras is a cut - show the new viewpoint immediately
+    if (main_camera != previous_camera) {
+        camera_cut_pending = true;
+        if (is_inside_tree() && detect_camera_cut()) {
+            force_reflection_refresh();
+        }
     }
 }
 
@@ -1065,7 +4976,7 @@ void PlanarReflectorCPP::set_reflection_camera_resolution(const Vector2i p_resol
     reflection_camera_resolution = p_resolution;
     
     // Apply new resolution immediately if viewport exists
-    if (reflect_viewport) {
+    if (reflect_viewport && !defer_to_batch(BATCH_DIRTY_RESIZE)) {
         reflect_viewport->set_size(reflection_camera_resolution);
     }
 }
@@ -1074,7 +4985,7 @@ Vector2i PlanarReflectorCPP::get_reflection_camera_resolution() const { return r
 
 // === CAMERA CONTROLS GETTERS/SETTERS ===
 
-void PlanarReflectorCPP::set_ortho_scale_multiplier(double p_multiplier) { ortho_scale_multiplier = p_multiplier; }
+void PlanarReflectorCPP::set_ortho_scale_multiplier(double p_multiplier) { ortho_scale_multiplier = p_multiplier; invalidate_reflection_cache(); }
 double PlanarReflectorCPP::get_ortho_scale_multiplier() const { return ortho_scale_multiplier; }
 
 void PlanarReflectorCPP::set_ortho_uv_scale(double p_scale) { ortho_uv_scale = p_scale; }
@@ -1083,10 +4994,36 @@ double PlanarReflectorCPP::get_ortho_uv_scale() const { return ortho_uv_scale; }
 void PlanarReflectorCPP::set_auto_detect_camera_mode(bool p_auto_detect) { auto_detect_camera_mode = p_auto_detect; }
 bool PlanarReflectorCPP::get_auto_detect_camera_mode() const { return auto_detect_camera_mode; }
 
+void PlanarReflectorCPP::set_ortho_scroll_cache(bool p_enable)
+{
+    ortho_scroll_cache = p_enable;
+    ortho_cache_valid = false;
+    ortho_scroll_offset = Vector2();
+
+    // Viewport size and camera extent change with the cache margin
+    last_viewport_check_frame = frame_counter - viewport_check_frequency;
+    invalidate_reflection_cache();
+}
+bool PlanarReflectorCPP::get_ortho_scroll_cache() const { return ortho_scroll_cache; }
+
+void PlanarReflectorCPP::set_ortho_cache_margin(double p_margin)
+{
+    ortho_cache_margin = Math::clamp(p_margin, 0.05, 1.0);
+    last_viewport_check_frame = frame_counter - viewport_check_frequency;
+    invalidate_reflection_cache();
+}
+double PlanarReflectorCPP::get_ortho_cache_margin() const { return ortho_cache_margin; }
+
 void PlanarReflectorCPP::set_reflection_layers(int p_layers)
 {
     reflection_layers = p_layers;    
-    
+    invalidate_reflection_cache();
+
+    // Split-screen views pick up the new mask on their next sync
+    if (reflect_viewport) {
+        sync_split_screen_views();
+    }
+
     // Apply layer mask to reflection camera immediately
     if (reflect_camera) {
         int cull_mask = reflection_layers;
@@ -1104,7 +5041,7 @@ void PlanarReflectorCPP::set_use_custom_environment(bool p_use_custom)
     use_custom_environment = p_use_custom;
     
     // Update environment immediately if we're ready
-    if (is_inside_tree()) {
+    if (is_inside_tree() && !defer_to_batch(BATCH_DIRTY_ENVIRONMENT)) {
         setup_reflection_environment();
     }
 }
@@ -1117,17 +5054,40 @@ void PlanarReflectorCPP::set_custom_environment(Environment *p_environment)
         custom_environment = Ref<Environment>(p_environment);
     } else {
         custom_environment.unref();  // Properly clear the Ref
-        UtilityFunctions::print("[PlanarReflectorCPP] Editor Environment NOT valid - clearing Custom Environment ");
+        ReflectionDiagnostics::report(REFLECTION_DIAG_INVALID_ENVIRONMENT, get_instance_id(), "Editor Environment NOT valid - clearing Custom Environment");
     }
 
     // Apply new environment if custom environments are enabled
-    if (use_custom_environment && is_inside_tree() && custom_environment.is_valid()) {
+    if (use_custom_environment && is_inside_tree() && custom_environment.is_valid() && !defer_to_batch(BATCH_DIRTY_ENVIRONMENT)) {
         setup_reflection_environment();
     }
 }
 
 Environment* PlanarReflectorCPP::get_custom_environment() const { return custom_environment.ptr(); }
 
+void PlanarReflectorCPP::set_derive_environment_from_camera(bool p_enable)
+{
+    derive_environment_from_camera = p_enable;
+    if (is_inside_tree()) {
+        if (!defer_to_batch(BATCH_DIRTY_ENVIRONMENT)) {
+            setup_reflection_environment();
+        }
+        invalidate_reflection_cache();
+    }
+}
+
+bool PlanarReflectorCPP::get_derive_environment_from_camera() const { return derive_environment_from_camera; }
+
+void PlanarReflectorCPP::set_reflection_environment_tier(int p_tier)
+{
+    reflection_environment_tier = Math::clamp(p_tier, 0, 2);
+    if (derive_environment_from_camera && is_inside_tree() && !defer_to_batch(BATCH_DIRTY_ENVIRONMENT)) {
+        setup_reflection_environment();
+    }
+}
+
+int PlanarReflectorCPP::get_reflection_environment_tier() const { return reflection_environment_tier; }
+
 void PlanarReflectorCPP::set_active_compositor(Compositor *p_compositor)
 {
     if (p_compositor) {
@@ -1137,7 +5097,7 @@ void PlanarReflectorCPP::set_active_compositor(Compositor *p_compositor)
     }
     
     // Apply compositor immediately if reflection system is ready
-    if (reflect_camera && is_inside_tree()) {
+    if (reflect_camera && is_inside_tree() && !defer_to_batch(BATCH_DIRTY_COMPOSITOR)) {
         setup_compositor_reflection_effect(reflect_camera);
     }
 }
@@ -1149,7 +5109,7 @@ void PlanarReflectorCPP::set_hide_intersect_reflections(bool p_hide)
     hide_intersect_reflections = p_hide;
     
     // Update compositor effect parameters immediately
-    if (reflect_camera && is_inside_tree()) {
+    if (reflect_camera && is_inside_tree() && !defer_to_batch(BATCH_DIRTY_COMPOSITOR_PARAMS)) {
         update_compositor_parameters();
     }
 }
@@ -1161,7 +5121,7 @@ void PlanarReflectorCPP::set_override_YAxis_height(bool p_override)
     override_YAxis_height = p_override;
     
     // Update compositor parameters with new height setting
-    if (reflect_camera && is_inside_tree()) {
+    if (reflect_camera && is_inside_tree() && !defer_to_batch(BATCH_DIRTY_COMPOSITOR_PARAMS)) {
         update_compositor_parameters();
     }
 }
@@ -1173,7 +5133,7 @@ void PlanarReflectorCPP::set_new_YAxis_height(double p_height)
     new_YAxis_height = p_height;
     
     // Update compositor parameters with new height value
-    if (reflect_camera && is_inside_tree()) {
+    if (reflect_camera && is_inside_tree() && !defer_to_batch(BATCH_DIRTY_COMPOSITOR_PARAMS)) {
         update_compositor_parameters();
     }
 }
@@ -1185,26 +5145,26 @@ void PlanarReflectorCPP::set_fill_reflection_experimental(bool p_fill)
     fill_reflection_experimental = p_fill;
     
     // Update compositor parameters with new fill setting
-    if (reflect_camera && is_inside_tree()) {
+    if (reflect_camera && is_inside_tree() && !defer_to_batch(BATCH_DIRTY_COMPOSITOR_PARAMS)) {
         update_compositor_parameters();
     }
 }
 
 bool PlanarReflectorCPP::get_fill_reflection_experimental() const { return fill_reflection_experimental; }
 
-void PlanarReflectorCPP::set_enable_reflection_offset(bool p_enable) { enable_reflection_offset = p_enable; }
+void PlanarReflectorCPP::set_enable_reflection_offset(bool p_enable) { enable_reflection_offset = p_enable; invalidate_reflection_cache(); }
 bool PlanarReflectorCPP::get_enable_reflection_offset() const { return enable_reflection_offset; }
 
-void PlanarReflectorCPP::set_reflection_offset_position(const Vector3 &p_position) { reflection_offset_position = p_position; }
+void PlanarReflectorCPP::set_reflection_offset_position(const Vector3 &p_position) { reflection_offset_position = p_position; invalidate_reflection_cache(); }
 Vector3 PlanarReflectorCPP::get_reflection_offset_position() const { return reflection_offset_position; }
 
-void PlanarReflectorCPP::set_reflection_offset_rotation(const Vector3 &p_rotation) { reflection_offset_rotation = p_rotation; }
+void PlanarReflectorCPP::set_reflection_offset_rotation(const Vector3 &p_rotation) { reflection_offset_rotation = p_rotation; invalidate_reflection_cache(); }
 Vector3 PlanarReflectorCPP::get_reflection_offset_rotation() const { return reflection_offset_rotation; }
 
-void PlanarReflectorCPP::set_reflection_offset_scale(double p_scale) { reflection_offset_scale = p_scale; }
+void PlanarReflectorCPP::set_reflection_offset_scale(double p_scale) { reflection_offset_scale = p_scale; invalidate_reflection_cache(); }
 double PlanarReflectorCPP::get_reflection_offset_scale() const { return reflection_offset_scale; }
 
-void PlanarReflectorCPP::set_offset_blend_mode(int p_mode) { offset_blend_mode = Math::clamp(p_mode, 0, 2); }
+void PlanarReflectorCPP::set_offset_blend_mode(int p_mode) { offset_blend_mode = Math::clamp(p_mode, 0, 2); invalidate_reflection_cache(); }
 int PlanarReflectorCPP::get_offset_blend_mode() const { return offset_blend_mode; }
 
 void PlanarReflectorCPP::set_update_frequency(int p_frequency) { update_frequency = Math::max(p_frequency, 1); }
@@ -1220,4 +5180,222 @@ void PlanarReflectorCPP::set_lod_distance_far(double p_distance) { lod_distance_
 double PlanarReflectorCPP::get_lod_distance_far() const { return lod_distance_far; }
 
 void PlanarReflectorCPP::set_lod_resolution_multiplier(double p_multiplier) { lod_resolution_multiplier = p_multiplier; }
-double PlanarReflectorCPP::get_lod_resolution_multiplier() const { return lod_resolution_multiplier; }
\ No newline at end of file
+double PlanarReflectorCPP::get_lod_resolution_multiplier() const { return lod_resolution_multiplier; }
+
+void PlanarReflectorCPP::set_min_reflection_size(int p_size)
+{
+    min_reflection_size = Math::clamp(p_size, 16, 512);
+    last_viewport_check_frame = frame_counter - viewport_check_frequency;  // Re-evaluate on the next check
+}
+int PlanarReflectorCPP::get_min_reflection_size() const { return min_reflection_size; }
+
+void PlanarReflectorCPP::set_surface_roughness(double p_roughness)
+{
+    surface_roughness = Math::clamp(p_roughness, 0.0, 1.0);
+    last_viewport_check_frame = frame_counter - viewport_check_frequency;  // Resize on next check
+}
+double PlanarReflectorCPP::get_surface_roughness() const { return surface_roughness; }
+
+void PlanarReflectorCPP::set_auto_detect_roughness(bool p_auto_detect)
+{
+    auto_detect_roughness = p_auto_detect;
+    last_viewport_check_frame = frame_counter - viewport_check_frequency;  // Resize on next check
+}
+bool PlanarReflectorCPP::get_auto_detect_roughness() const { return auto_detect_roughness; }
+
+void PlanarReflectorCPP::set_roughness_min_resolution_scale(double p_scale) { roughness_min_resolution_scale = Math::clamp(p_scale, 0.05, 1.0); }
+double PlanarReflectorCPP::get_roughness_min_resolution_scale() const { return roughness_min_resolution_scale; }
+
+void PlanarReflectorCPP::set_static_until_changed(bool p_enable)
+{
+    static_until_changed = p_enable;
+
+    if (static_until_changed) {
+        acquire_content_tracker();
+    } else {
+        release_content_tracker();
+    }
+    invalidate_reflection_cache();
+}
+bool PlanarReflectorCPP::get_static_until_changed() const { return static_until_changed; }
+
+void PlanarReflectorCPP::set_auto_track_reflected_nodes(bool p_enable)
+{
+    auto_track_reflected_nodes = p_enable;
+    content_changed_pending = true;
+}
+bool PlanarReflectorCPP::get_auto_track_reflected_nodes() const { return auto_track_reflected_nodes; }
+
+void PlanarReflectorCPP::set_max_staleness(double p_seconds) { max_staleness = Math::max(p_seconds, 0.0); }
+double PlanarReflectorCPP::get_max_staleness() const { return max_staleness; }
+
+void PlanarReflectorCPP::set_pose_cache(bool p_enable)
+{
+    pose_cache = p_enable;
+    if (!pose_cache) {
+        flush_pose_cache();
+    }
+}
+bool PlanarReflectorCPP::get_pose_cache() const { return pose_cache; }
+
+void PlanarReflectorCPP::set_pose_cache_memory_mb(int p_megabytes)
+{
+    pose_cache_memory_mb = Math::clamp(p_megabytes, 1, 2048);
+    trim_pose_cache();
+}
+int PlanarReflectorCPP::get_pose_cache_memory_mb() const { return pose_cache_memory_mb; }
+
+void PlanarReflectorCPP::set_reflection_priority(int p_priority) { reflection_priority = Math::clamp(p_priority, 0, 100); }
+int PlanarReflectorCPP::get_reflection_priority() const { return reflection_priority; }
+
+void PlanarReflectorCPP::set_interleaved_rendering(bool p_enable)
+{
+    interleaved_rendering = p_enable;
+    if (reflect_viewport) {
+        sync_interleave_rig();
+        update_shader_parameters();
+    }
+}
+bool PlanarReflectorCPP::get_interleaved_rendering() const { return interleaved_rendering; }
+
+void PlanarReflectorCPP::set_double_buffered_reflections(bool p_enable)
+{
+    double_buffered_reflections = p_enable;
+    if (reflect_viewport) {
+        sync_interleave_rig();
+        sync_double_buffer_rig();
+        apply_viewport_update_mode();
+        update_shader_parameters();
+    }
+}
+bool PlanarReflectorCPP::get_double_buffered_reflections() const { return double_buffered_reflections; }
+
+void PlanarReflectorCPP::set_event_driven(bool p_enable)
+{
+    event_driven = p_enable;
+    wake_reflector();  // Sleep again from _process if idle
+}
+bool PlanarReflectorCPP::get_event_driven() const { return event_driven; }
+
+void PlanarReflectorCPP::set_show_cost_overlay(bool p_enable)
+{
+    show_cost_overlay = p_enable;
+    if (show_cost_overlay) {
+        update_cost_overlay();
+    } else {
+        remove_cost_overlay();
+    }
+}
+bool PlanarReflectorCPP::get_show_cost_overlay() const { return show_cost_overlay; }
+
+void PlanarReflectorCPP::set_cost_overlay_metric(int p_metric)
+{
+    cost_overlay_metric = Math::clamp(p_metric, 0, 1);
+    if (show_cost_overlay) {
+        update_cost_overlay();
+    }
+}
+int PlanarReflectorCPP::get_cost_overlay_metric() const { return cost_overlay_metric; }
+
+void PlanarReflectorCPP::set_tight_reflection_clip(bool p_enable)
+{
+    tight_reflection_clip = p_enable;
+    if (!tight_reflection_clip && reflect_camera) {
+        // Back to Camera3D defaults and the full intersect pass
+        reflect_camera->set_near(0.05);
+        reflect_camera->set_far(4000.0);
+        intersect_pass_redundant = false;
+        if (!defer_to_batch(BATCH_DIRTY_COMPOSITOR_PARAMS)) {
+            update_compositor_parameters();
+        }
+    }
+    invalidate_reflection_cache();
+}
+bool PlanarReflectorCPP::get_tight_reflection_clip() const { return tight_reflection_clip; }
+
+void PlanarReflectorCPP::set_reflection_draw_distance(double p_distance) { reflection_draw_distance = Math::max(p_distance, 0.0); invalidate_reflection_cache(); }
+double PlanarReflectorCPP::get_reflection_draw_distance() const { return reflection_draw_distance; }
+
+void PlanarReflectorCPP::set_skip_empty_reflections(bool p_enable)
+{
+    skip_empty_reflections = p_enable;
+    if (!skip_empty_reflections && reflection_empty) {
+        reflection_empty = false;
+        invalidate_reflection_cache();
+    }
+}
+bool PlanarReflectorCPP::get_skip_empty_reflections() const { return skip_empty_reflections; }
+
+void PlanarReflectorCPP::set_occlusion_culling(bool p_enable)
+{
+    occlusion_culling = p_enable;
+    if (!occlusion_culling && reflection_occluded && reflect_viewport) {
+        update_occlusion_state();  // Reveals and renders
+    }
+}
+bool PlanarReflectorCPP::get_occlusion_culling() const { return occlusion_culling; }
+
+void PlanarReflectorCPP::set_use_instance_uniforms(bool p_enable)
+{
+    use_instance_uniforms = p_enable;
+    if (reflect_viewport) {
+        update_shader_parameters();
+    }
+}
+bool PlanarReflectorCPP::get_use_instance_uniforms() const { return use_instance_uniforms; }
+
+void PlanarReflectorCPP::set_split_screen_updates_per_frame(int p_updates) { split_screen_updates_per_frame = Math::clamp(p_updates, 1, MAX_SPLIT_SCREEN_VIEWS); }
+int PlanarReflectorCPP::get_split_screen_updates_per_frame() const { return split_screen_updates_per_frame; }
+
+void PlanarReflectorCPP::set_split_screen_pixel_budget(int64_t p_pixels) { split_screen_pixel_budget = Math::max(p_pixels, (int64_t)0); }
+int64_t PlanarReflectorCPP::get_split_screen_pixel_budget() const { return split_screen_pixel_budget; }
+
+void PlanarReflectorCPP::set_split_screen_first_layer(int p_layer)
+{
+    if (split_screen_layers_applied) {
+        // Hand the old player layers back before taking the new ones
+        LocalVector<SplitScreenView> views = split_screen_views;
+        split_screen_views.clear();
+        apply_split_screen_layers();
+        split_screen_views = views;
+    }
+    split_screen_first_layer = Math::clamp(p_layer, 1, 17);
+    if (!split_screen_views.is_empty() && reflect_viewport) {
+        sync_split_screen_views();
+    }
+}
+int PlanarReflectorCPP::get_split_screen_first_layer() const { return split_screen_first_layer; }
+
+void PlanarReflectorCPP::set_camera_cut_distance(double p_distance) { camera_cut_distance = Math::max(p_distance, 0.0); }
+double PlanarReflectorCPP::get_camera_cut_distance() const { return camera_cut_distance; }
+
+void PlanarReflectorCPP::set_camera_cut_angle(double p_degrees) { camera_cut_angle = Math::clamp(p_degrees, 0.0, 180.0); }
+double PlanarReflectorCPP::get_camera_cut_angle() const { return camera_cut_angle; }
+
+void PlanarReflectorCPP::set_predictive_camera(bool p_enable)
+{
+    predictive_camera = p_enable;
+    reset_camera_motion();
+    if (reflect_viewport) {
+        update_shader_parameters();
+    }
+}
+bool PlanarReflectorCPP::get_predictive_camera() const { return predictive_camera; }
+
+void PlanarReflectorCPP::set_prediction_overscan(double p_fraction)
+{
+    prediction_overscan = Math::clamp(p_fraction, 0.0, 0.5);
+    if (reflect_viewport) {
+        update_shader_parameters();
+    }
+}
+double PlanarReflectorCPP::get_prediction_overscan() const { return prediction_overscan; }
+
+void PlanarReflectorCPP::set_lazy_rig_allocation(bool p_lazy) { lazy_rig_allocation = p_lazy; }
+bool PlanarReflectorCPP::get_lazy_rig_allocation() const { return lazy_rig_allocation; }
+
+void PlanarReflectorCPP::set_rig_release_timeout(double p_seconds) { rig_release_timeout = Math::max(p_seconds, 0.0); }
+double PlanarReflectorCPP::get_rig_release_timeout() const { return rig_release_timeout; }
+
+void PlanarReflectorCPP::set_prewarm_on_ready(bool p_enable) { prewarm_on_ready = p_enable; }
+bool PlanarReflectorCPP::get_prewarm_on_ready() const { return prewarm_on_ready; }
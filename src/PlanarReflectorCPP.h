@@ -12,12 +12,28 @@
 #include <godot_cpp/classes/camera_attributes.hpp>
 #include <godot_cpp/classes/compositor.hpp>
 #include <godot_cpp/classes/compositor_effect.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/label3d.hpp>
+#include <godot_cpp/classes/immediate_mesh.hpp>
+#include <godot_cpp/classes/quad_mesh.hpp>
+#include <godot_cpp/classes/standard_material3d.hpp>
 #include <godot_cpp/variant/transform3d.hpp>
 #include <godot_cpp/variant/vector3.hpp>
 #include <godot_cpp/variant/vector2i.hpp>
 #include <godot_cpp/variant/plane.hpp>
 #include <godot_cpp/variant/basis.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/aabb.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hashfuncs.hpp>
+
+#include "ReflectionContentTracker.h"
+#include "ReflectionOcclusion.h"
+#include "ReflectorVisibilitySet.h"
+
 // Forward declaration for our C++ ReflectionEffectPrePass
 namespace godot {
     class ReflectionEffectPrePass;
@@ -47,11 +63,194 @@ namespace godot {
         double ortho_uv_scale = 1.0;
         bool auto_detect_camera_mode = true;
 
+        // Orthographic scrolling cache - pans shift UVs inside an oversized render
+        bool ortho_scroll_cache = false;
+        double ortho_cache_margin = 0.25;
+        bool ortho_cache_valid = false;
+        Transform3D ortho_cache_camera_transform = Transform3D();
+        double ortho_cache_camera_size = 0.0;
+        Plane ortho_cache_plane = Plane();
+        Vector2 ortho_scroll_offset = Vector2();
+
+        // On-demand rendering state shared by caching modes
+        bool reflection_cache_dirty = true;
+        bool reflection_render_requested = false;
+        // SubViewport::get_update_mode() keeps reporting UPDATE_ONCE after the render was drawn,
+        // so pending single renders are tracked by the process frame they were requested in
+        uint64_t single_render_frame = UINT64_MAX;
+
+        // Content-change tracking ("static until changed") - one tracker shared by all reflectors
+        static ReflectionContentTracker content_tracker;
+        static int content_tracker_users;
+        LocalVector<uint64_t> manual_tracked_ids;   // track_reflected_node registrations
+        uint64_t content_change_cursor = 0;         // Next content_tracker log entry to read
+        bool static_until_changed = false;
+        bool auto_track_reflected_nodes = true;
+        double max_staleness = 5.0;
+        double time_since_render = 0.0;
+        bool content_changed_pending = false;
+        bool content_tracker_acquired = false;
+        Transform3D last_rendered_reflection_transform = Transform3D();
+
+        // Pose cache - finished static renders parked per quantized pose, least recently used first out
+        struct PoseCacheEntry {
+            Array key;                      // Quantized pose values, compared in full on lookup
+            uint32_t key_hash = 0;          // Hash of key - rejects most entries without comparing
+            SubViewport *viewport = nullptr;
+            Camera3D *camera = nullptr;     // Freed together with its viewport
+            uint64_t last_used_usec = 0;
+            uint64_t render_usec = 0;
+        };
+        static constexpr double POSE_CACHE_POSITION_STEP = 0.01;  // Quantization of positions (units)
+        static constexpr double POSE_CACHE_ROTATION_STEP = 0.001; // Quantization of basis components
+        bool pose_cache = false;
+        int pose_cache_memory_mb = 64;
+        LocalVector<PoseCacheEntry> pose_cache_entries;
+        Array current_pose_key;
+        uint32_t current_pose_key_hash = 0;
+        bool current_pose_valid = false;
+        uint64_t current_pose_render_usec = 0;
+
+        // Visibility and global VRAM budget
+        static LocalVector<PlanarReflectorCPP *> registered_reflectors;
+        static int64_t vram_budget_bytes;
+        static uint64_t last_budget_pass_frame;
+        static const int REFLECTION_SHADOW_ATLAS_SIZE = 2048;
+        int reflection_priority = 50;
+        bool is_visible_to_active_camera = true;
+        uint64_t last_visible_usec = 0;
+        bool budget_evicted = false;
+        int64_t evicted_vram_bytes = 0;
+
+        // Software occlusion culling - one CPU depth buffer per frame, shared by all reflectors
+        static ReflectionOcclusionBuffer occlusion_buffer;
+        static uint64_t occlusion_camera_id;
+        static uint64_t last_occlusion_pass_frame;
+        static uint64_t occluder_list_frame;
+        static LocalVector<uint64_t> occluder_node_ids;
+        static HashMap<uint64_t, PackedVector3Array> occluder_face_cache;  // Mesh::get_faces per mesh
+        static const int OCCLUDER_REFRESH_FRAMES = 60;   // Re-scan the tree for occluders this often
+        static const int OCCLUSION_HIDE_FRAMES = 8;      // Consecutive occluded frames before rendering stops
+        static const int OCCLUSION_REVEAL_MARGIN = 2;    // Buffer pixels - hidden reflectors wake up early
+
+        // Baked potentially-visible sets - one lookup per frame for all reflectors
+        static Ref<ReflectorVisibilitySet> visibility_set;
+        static int visibility_cell;
+        static uint64_t last_visibility_pass_frame;
+        static bool visibility_indices_dirty;
+        int visibility_set_index = -1;  // This reflector in visibility_set, -1 = not baked
+        bool pvs_culled = false;
+
+        // Event-driven processing - no _process callbacks while idle
+        static bool event_scheduler_connected;
+        static const uint64_t EVENT_HEARTBEAT_USEC = 1000000;  // Sleepers re-check size/budget once a second
+        bool event_driven = false;
+        bool process_sleeping = false;
+        bool wake_update_pending = false;
+        bool wake_checks_pending = false;
+        uint64_t sleep_started_usec = 0;
+        Transform3D sleep_camera_transform = Transform3D();
+
+        // Interleaved rendering - two full-size phase targets, one rendered per frame with half its columns masked
+        bool interleaved_rendering = false;
+        SubViewport *interleave_viewport = nullptr;
+        Camera3D *interleave_camera = nullptr;
+        int interleave_phase = 0;
+        Vector2i interleave_full_size = Vector2i();
+        Transform3D interleave_phase_transforms[2];
+        Transform3D interleave_previous_transform = Transform3D();
+        RID interleave_mask_instance;       // RenderingServer instance - no node, so no scene query sees it
+        Ref<QuadMesh> interleave_mask_mesh;
+        Ref<ShaderMaterial> interleave_mask_material;
+        uint32_t interleave_mask_layer_bit = 0;     // Layer only this reflector's phase cameras render, 0 = none free
+        static constexpr uint32_t INTERLEAVE_MASK_LAYERS = 0xFFF00000u;  // Layers 21-32, beyond the 20 nodes are placed on
+        static uint32_t interleave_mask_layers_in_use;
+
+        // Double-buffered targets - reflect_viewport is the back buffer, the front one is sampled
+        bool double_buffered_reflections = false;
+        SubViewport *front_buffer_viewport = nullptr;
+        Camera3D *front_buffer_camera = nullptr;
+        bool buffer_swap_pending = false;
+        int buffer_render_frame = 0;
+
+        // Cost overlay / heatmap
+        bool show_cost_overlay = false;
+        int cost_overlay_metric = 0;  // 0 = megapixels per second, 1 = update rate
+        Label3D *cost_overlay_label = nullptr;
+        MeshInstance3D *cost_overlay_outline = nullptr;
+        MeshInstance3D *cost_overlay_tint = nullptr;
+        Ref<StandardMaterial3D> cost_overlay_material;
+        Ref<StandardMaterial3D> cost_overlay_line_material;
+        Ref<ImmediateMesh> cost_overlay_outline_mesh;
+        AABB cost_overlay_outline_bounds = AABB();  // Bounds the outline mesh was last built for
+        uint64_t cost_window_pixels = 0;
+        uint32_t cost_window_renders = 0;
+        double cost_window_time = 0.0;
+        double rendered_megapixels_per_second = 0.0;
+        double renders_per_second = 0.0;
+
+        // Binary per-frame trace capture (see ReflectionTrace.h)
+        Ref<FileAccess> trace_file;
+        bool trace_frame_rendered = false;  // count_reflection_render ran since the last record
+
+        // Property batching - deferred work flushed once per commit
+        enum BatchDirtyFlags {
+            BATCH_DIRTY_ENVIRONMENT = 1 << 0,
+            BATCH_DIRTY_COMPOSITOR = 1 << 1,
+            BATCH_DIRTY_COMPOSITOR_PARAMS = 1 << 2,
+            BATCH_DIRTY_RESIZE = 1 << 3,
+        };
+        int batch_depth = 0;
+        uint32_t batch_dirty = 0;
+
+        // Reflection camera clip range
+        bool tight_reflection_clip = false;
+        double reflection_draw_distance = 0.0;
+        bool intersect_pass_redundant = false;
+
+        // Empty-mirror fast path
+        bool skip_empty_reflections = false;
+        bool reflection_empty = false;
+
+        // Occlusion culling against OccluderInstance3D and "reflection_occluders" meshes
+        bool occlusion_culling = false;
+        bool reflection_occluded = false;
+        int occlusion_hidden_frames = 0;
+
+        // Lazy rig allocation and release on prolonged invisibility
+        bool lazy_rig_allocation = false;
+        double rig_release_timeout = 0.0;
+        bool rig_setup_started = false;
+
+        // Prewarm - one tiny offscreen render at load time compiles the reflection pipelines
+        static constexpr int PREWARM_VIEWPORT_SIZE = 16;
+        bool prewarm_on_ready = false;
+        bool prewarm_requested = false;     // Prewarm once the rig exists
+        bool prewarm_in_progress = false;   // Prewarm render pending, real size and schedule on hold
+        uint64_t prewarm_frame = 0;         // Process frame the prewarm render was scheduled in
+
         // Layer and environment control
         int reflection_layers = 1;
         bool use_custom_environment = false;
         Ref<Environment> custom_environment;
 
+        // Environment derived from the main camera / world, shared between reflectors
+        struct DerivedEnvironmentKey {
+            uint64_t source_id = 0;     // Source Environment - checked against ObjectDB before reuse
+            int tier = 0;
+            bool operator==(const DerivedEnvironmentKey &other) const { return source_id == other.source_id && tier == other.tier; }
+        };
+        struct DerivedEnvironmentKeyHasher {
+            static uint32_t hash(const DerivedEnvironmentKey &key) { return hash_murmur3_one_64(key.source_id, hash_murmur3_one_32(key.tier)); }
+        };
+        struct DerivedEnvironment {
+            Ref<Environment> environment;
+            uint32_t fingerprint = 0;
+        };
+        static HashMap<DerivedEnvironmentKey, DerivedEnvironment, DerivedEnvironmentKeyHasher> derived_environment_cache;
+        bool derive_environment_from_camera = false;
+        int reflection_environment_tier = 1;  // 0 = Low, 1 = Medium, 2 = High
+
         // Reflection Compositor Effects
         // bool use_custom_compositor = false;
         Ref<Compositor> active_compositor;
@@ -73,6 +272,13 @@ namespace godot {
         double lod_distance_near = 10.0;
         double lod_distance_far = 25.0;
         double lod_resolution_multiplier = 0.45;
+        int min_reflection_size = 128;  // Smallest target edge LOD and roughness may shrink to
+
+        // Roughness-aware resolution (blurred reflections need fewer pixels)
+        double surface_roughness = 0.0;
+        bool auto_detect_roughness = true;
+        double roughness_min_resolution_scale = 0.125;
+        double detected_roughness = -1.0;
 
         // Internal optimization variables
         int frame_counter = 0;
@@ -81,6 +287,45 @@ namespace godot {
         double position_threshold = 0.01;
         double rotation_threshold = 0.001;
 
+        // Camera-cut detection
+        double camera_cut_distance = 5.0;
+        double camera_cut_angle = 45.0;
+        uint64_t last_tracked_camera_id = 0;
+        bool camera_cut_pending = false;
+
+        // Shader parameter targets - every ShaderMaterial surface, or instance uniforms
+        bool use_instance_uniforms = false;
+
+        // Predictive extrapolation - camera motion sampled at each reflection update
+        static constexpr double PREDICTION_SMOOTHING = 0.5;      // Weight of the newest velocity sample
+        static constexpr double PREDICTION_MAX_LEAD = 0.25;      // Seconds - never extrapolate further
+        static constexpr double PREDICTION_MAX_SAMPLE_GAP = 0.5; // Seconds - older samples restart tracking
+        bool predictive_camera = false;
+        double prediction_overscan = 0.1;
+        Transform3D motion_sample_transform = Transform3D();
+        uint64_t motion_sample_usec = 0;
+        Vector3 camera_linear_velocity = Vector3();
+        Vector3 camera_angular_velocity = Vector3();
+        double camera_update_interval = 0.0;
+        Transform3D rendered_reflection_transform = Transform3D();
+
+        // Split-screen: extra cameras, each with its own reflection target
+        struct SplitScreenView {
+            uint64_t camera_id = 0;
+            SubViewport *viewport = nullptr;
+            Camera3D *camera = nullptr;
+            MeshInstance3D *proxy = nullptr;    // This mesh on the player's layer, selects the view by index
+        };
+        static const int MAX_SPLIT_SCREEN_VIEWS = 3; // Plus the primary camera = 4 players
+        LocalVector<SplitScreenView> split_screen_views;
+        uint32_t split_screen_next_update = 0;
+        int split_screen_updates_per_frame = 1;
+        int64_t split_screen_pixel_budget = 0;
+        int split_screen_first_layer = 17;          // Layers 17-20: one per player's copy of the mesh
+        uint32_t split_screen_saved_layer_mask = 0; // Own layers before split-screen took them over
+        HashMap<uint64_t, uint32_t> split_screen_saved_cull_masks;  // Player cameras' own cull masks, by instance id
+        bool split_screen_layers_applied = false;
+
         // Cached calculations
         Plane cached_reflection_plane = Plane();
         bool is_layer_one_active = true;
@@ -95,6 +340,9 @@ namespace godot {
         double last_distance_check = -1.0;
         double cached_lod_factor = 1.0;
 
+        // Transform notifications coalesced into one update per frame
+        bool reflector_transform_dirty = false;
+
         // Core setup methods - SIMPLIFIED
         void initial_setup();
         void setup_reflection_camera_and_viewport();
@@ -119,11 +367,153 @@ namespace godot {
         Transform3D apply_reflection_offset(const Transform3D &base_transform);
         // void update_offset_cache();
         bool should_update_reflection(Camera3D *active_cam);
+
+        // Predictive extrapolation
+        bool is_prediction_active() const;
+        void track_camera_motion(const Transform3D &cam_transform);
+        void reset_camera_motion();
+        Transform3D get_predicted_camera_transform(Camera3D *cam) const;
+        void apply_prediction_overscan(Camera3D *cam) const;
+
+        // Orthographic scroll cache and on-demand rendering
+        bool is_ortho_scroll_cache_active() const;
+        bool update_ortho_scroll_cache(Camera3D *active_cam);
+        void anchor_ortho_scroll_cache(Camera3D *active_cam);
+        Vector2 get_ortho_view_extent(Camera3D *cam) const;
+        double get_ortho_cache_extent_scale() const;
+        bool uses_on_demand_rendering() const;
+        void request_reflection_render();
+        void apply_viewport_update_mode();
+        void render_reflection_once();
+        bool is_single_render_pending() const;
+
+        // Content-change tracking
+        bool detect_tracked_content_changes();
+        bool is_aabb_in_reflection_frustum(const AABB &world_aabb, const TypedArray<Plane> &frustum) const;
+        bool is_tracked_for_reflection(uint64_t instance_id, bool is_light, uint32_t layer_mask, uint64_t reflector_id) const;
+        void acquire_content_tracker();
+        void release_content_tracker();
+        static void on_scene_node_added(Node *node);
+        static void on_scene_node_removed(Node *node);
+        static void trim_content_log();
+
+        // Pose cache
+        bool is_pose_cache_active() const;
+        Array compute_pose_key(const Transform3D &reflection_transform) const;
+        bool use_cached_pose(const Transform3D &reflection_transform);
+        PoseCacheEntry acquire_pose_cache_rig();
+        void trim_pose_cache();
+        void flush_pose_cache();
+        void free_pose_cache_rig(PoseCacheEntry &entry);
+        int64_t get_pose_cache_bytes() const;
+
+        // Visibility and VRAM budget
+        bool is_visible_to_camera(Camera3D *cam) const;
+        void update_visibility_state();
+        bool is_environment_only() const;
+        double get_invisible_seconds() const;
+        void evict_reflection_targets();
+        void restore_reflection_targets();
+        static void enforce_vram_budget();
+        static bool is_less_important(const PlanarReflectorCPP *a, const PlanarReflectorCPP *b);
+        void estimate_vram(int64_t &r_color, int64_t &r_depth, int64_t &r_shadow, int64_t &r_compositor) const;
+        void update_rig_lifetime();
+        bool detect_camera_cut();
+
+        // Split-screen views
+        void sync_split_screen_views();
+        void update_split_screen_view_sizes();
+        void update_split_screen_views();
+        void push_split_screen_shader_parameters(const LocalVector<ShaderMaterial *> &materials);
+        void free_split_screen_view(SplitScreenView &view);
+        void sync_split_screen_proxy(SplitScreenView &view, int view_index);
+        void free_split_screen_proxy(SplitScreenView &view);
+        void apply_split_screen_layers();
+        void restore_split_screen_cull_masks(const LocalVector<uint64_t> &keep_camera_ids);
+        uint32_t get_split_screen_layer_bit(int view_index) const;
+
+        // Interleaved rendering
+        bool is_interleave_wanted() const;
+        bool is_interleaving_active() const;
+        void sync_interleave_rig();
+        void free_interleave_rig();
+        void update_interleave_camera(Camera3D *source_cam);
+        void create_interleave_mask();
+        void free_interleave_mask();
+        void update_interleave_mask(Camera3D *phase_camera);
+        void advance_interleave_phase();
+        void push_interleave_shader_parameters(const LocalVector<ShaderMaterial *> &materials);
+
+        // Double-buffered targets
+        bool is_double_buffer_wanted() const;
+        bool is_double_buffering_active() const;
+        void sync_double_buffer_rig();
+        void free_double_buffer_rig();
+        void swap_reflection_buffers();
+        SubViewport *get_sampled_viewport() const;
+
+        // Event-driven processing
+        bool can_sleep() const;
+        void enter_process_sleep();
+        void wake_reflector();
+        static void on_event_scheduler_tick();
+        void connect_event_scheduler();
+        static void disconnect_event_scheduler(SceneTree *tree);
+
+        // Prewarm
+        void start_prewarm_render();
+        void finish_prewarm_render();
+
+        // Cost overlay
+        void count_reflection_render(const Vector2i &size);
+        void accumulate_render_cost(double delta);
+        void update_cost_overlay();
+        void remove_cost_overlay();
+        bool shares_reflection_material() const;
+        uint32_t get_cost_overlay_layer_bit() const;
+
+        // Per-frame work and trace capture
+        uint32_t process_reflection(double delta);
+        void write_trace_record(double delta, uint32_t flags, uint64_t elapsed_usec);
+
+        // Property batching
+        bool defer_to_batch(uint32_t p_flags);
+        void flush_batch();
+
+        // Derived reflection environment
+        Ref<Environment> get_source_environment();
+        bool refresh_derived_environment();
+        static uint32_t compute_environment_fingerprint(const Ref<Environment> &source);
+        static void strip_environment_for_tier(const Ref<Environment> &environment, int tier);
+        static void prune_derived_environments();
+
+        // Reflection camera clip range
+        bool fit_reflection_clip_planes(Camera3D *target_cam, const Transform3D &reflection_transform, Camera3D *source_cam);
+
+        // Empty-mirror fast path
+        void update_empty_reflection_state();
+        void update_occlusion_state();
+        static void build_occlusion_buffer(Camera3D *cam);
+        static void apply_reflector_visibility_set(Camera3D *cam);
+        void resolve_visibility_set_index();
+        void set_pvs_culled(bool p_culled);
+        static void refresh_occluder_list(SceneTree *tree);
+        bool has_reflected_geometry() const;
         
         // Performance helper methods
         Vector2i get_target_viewport_size();
         Vector2i apply_lod_to_size(Vector2i target_size, Camera3D *active_cam);
+        Vector2i apply_roughness_to_size(Vector2i target_size);
+        double get_effective_roughness() const;
+        void detect_material_roughness(ShaderMaterial *material);
         void create_viewport_deferred();
+        SubViewport *create_reflection_subviewport(const String &viewport_name, Camera3D *&r_camera);
+        Transform3D compute_reflection_transform(Camera3D *source_cam, const Plane &reflection_plane);
+        Transform3D compute_reflection_transform(const Transform3D &source_transform, const Plane &reflection_plane);
+        void copy_camera_projection(Camera3D *source_cam, Camera3D *target_cam, double extent_scale);
+        double compute_lod_factor(double distance) const;
+        bool gather_reflection_materials(LocalVector<ShaderMaterial *> &r_materials) const;
+        void set_reflection_parameter(const LocalVector<ShaderMaterial *> &materials, const StringName &p_name, const Variant &p_value);
         void clear_shader_texture_references();
         void finalize_setup();
 
@@ -136,6 +526,7 @@ namespace godot {
 
         void _process(double delta) override; 
         void _ready() override;
+        void _enter_tree() override;
         void _exit_tree() override;
         void _notification(int what);
         
@@ -145,6 +536,83 @@ namespace godot {
         void set_editor_camera(Camera3D *viewport_camera);
         Camera3D* get_active_camera(); // Returns active camera for plugin helper
         bool is_planar_reflector_active();
+        void invalidate_reflection_cache(); // Forces a re-render when scene content changed
+        void force_reflection_refresh();    // Bypasses all throttles for an immediate full update
+
+        // Registration API for content-change tracking
+        void track_reflected_node(Node3D *p_node);
+        void untrack_reflected_node(Node3D *p_node);
+        void clear_tracked_nodes();
+        int get_tracked_node_count() const;
+
+        // VRAM accounting - per reflector and process-wide
+        int64_t get_estimated_vram_bytes() const;
+        Dictionary get_vram_usage_breakdown() const;
+        bool is_budget_evicted() const;
+
+        // Event-driven state
+        bool is_process_sleeping() const;
+
+        // Cost overlay - render cost and skip reason for level designers
+        String get_skip_reason() const;
+        double get_rendered_megapixels_per_second() const;
+        double get_renders_per_second() const;
+        static void set_cost_overlay_for_all(bool p_enable);
+
+        // Trace capture - one binary record per processed frame for offline replay
+        bool start_trace_capture(const String &p_path);
+        void stop_trace_capture();
+        bool is_trace_capturing() const;
+
+        // Diagnostics - counters and recent events shared by all reflectors
+        static Dictionary get_diagnostic_counts();
+        static Array get_recent_diagnostics(int p_max_events);
+        static void clear_diagnostics();
+        static void set_diagnostics_print_enabled(bool p_enabled);
+        static bool get_diagnostics_print_enabled();
+        static void set_diagnostics_print_interval(double p_seconds);
+        static double get_diagnostics_print_interval();
+
+        // Property batching - bulk changes do environment/compositor/resize work once
+        void begin_batch();
+        void commit_batch();
+        bool is_batching() const;
+        void apply_settings(const Dictionary &p_settings);
+
+        // Split-screen cameras - each gets its own mirrored view and target
+        void add_split_screen_camera(Camera3D *p_camera);
+        void remove_split_screen_camera(Camera3D *p_camera);
+        void clear_split_screen_cameras();
+        TypedArray<Camera3D> get_split_screen_cameras() const;
+
+        // Empty-mirror state
+        bool is_reflection_empty() const;
+
+        // Occlusion state
+        bool is_reflection_occluded() const;
+
+        // Baked visibility - process-wide potentially-visible sets
+        static void set_reflector_visibility_set(const Ref<ReflectorVisibilitySet> &p_set);
+        static Ref<ReflectorVisibilitySet> get_reflector_visibility_set();
+
+        // Drops process-wide resource references before the extension unloads
+        static void release_shared_resources();
+        static void release_derived_environments();
+        bool is_pvs_culled() const;
+
+        // Rig lifetime
+        void release_reflection_rig();
+        bool is_reflection_rig_allocated() const;
+
+        // Prewarm - compile reflection pipelines during loading instead of at first sight
+        void prewarm_reflection();
+        bool is_prewarming() const;
+        static void prewarm_all_reflectors();
+
+        static void set_reflection_vram_budget(int64_t p_bytes);
+        static int64_t get_reflection_vram_budget();
+        static int64_t get_total_reflection_vram();
+        static Array get_reflection_vram_report();
 
         // Setters and Getters
         void set_is_active(bool p_active);
@@ -167,6 +635,12 @@ namespace godot {
         void set_auto_detect_camera_mode(bool p_auto_detect);
         bool get_auto_detect_camera_mode() const;
 
+        void set_ortho_scroll_cache(bool p_enable);
+        bool get_ortho_scroll_cache() const;
+
+        void set_ortho_cache_margin(double p_margin);
+        double get_ortho_cache_margin() const;
+
         // Reflection Layers and Environment Group
         void set_reflection_layers(int p_layers);
         int get_reflection_layers() const;
@@ -177,6 +651,12 @@ namespace godot {
         void set_custom_environment(Environment *p_environment);
         Environment *get_custom_environment() const;
 
+        void set_derive_environment_from_camera(bool p_enable);
+        bool get_derive_environment_from_camera() const;
+
+        void set_reflection_environment_tier(int p_tier);
+        int get_reflection_environment_tier() const;
+
         // Reflection Compositor Effects Group
         // void set_use_custom_compositor(bool p_use_custom);
         // bool get_use_custom_compositor() const;
@@ -227,6 +707,96 @@ namespace godot {
 
         void set_lod_resolution_multiplier(double p_multiplier);
         double get_lod_resolution_multiplier() const;
+
+        void set_min_reflection_size(int p_size);
+        int get_min_reflection_size() const;
+
+        void set_surface_roughness(double p_roughness);
+        double get_surface_roughness() const;
+
+        void set_auto_detect_roughness(bool p_auto_detect);
+        bool get_auto_detect_roughness() const;
+
+        void set_roughness_min_resolution_scale(double p_scale);
+        double get_roughness_min_resolution_scale() const;
+
+        void set_static_until_changed(bool p_enable);
+        bool get_static_until_changed() const;
+
+        void set_auto_track_reflected_nodes(bool p_enable);
+        bool get_auto_track_reflected_nodes() const;
+
+        void set_max_staleness(double p_seconds);
+        double get_max_staleness() const;
+
+        void set_pose_cache(bool p_enable);
+        bool get_pose_cache() const;
+
+        void set_pose_cache_memory_mb(int p_megabytes);
+        int get_pose_cache_memory_mb() const;
+
+        void set_reflection_priority(int p_priority);
+        int get_reflection_priority() const;
+
+        void set_interleaved_rendering(bool p_enable);
+        bool get_interleaved_rendering() const;
+
+        void set_double_buffered_reflections(bool p_enable);
+        bool get_double_buffered_reflections() const;
+
+        void set_event_driven(bool p_enable);
+        bool get_event_driven() const;
+
+        void set_show_cost_overlay(bool p_enable);
+        bool get_show_cost_overlay() const;
+
+        void set_cost_overlay_metric(int p_metric);
+        int get_cost_overlay_metric() const;
+
+        void set_tight_reflection_clip(bool p_enable);
+        bool get_tight_reflection_clip() const;
+
+        void set_reflection_draw_distance(double p_distance);
+        double get_reflection_draw_distance() const;
+
+        void set_skip_empty_reflections(bool p_enable);
+        bool get_skip_empty_reflections() const;
+
+        void set_occlusion_culling(bool p_enable);
+        bool get_occlusion_culling() const;
+
+        void set_split_screen_updates_per_frame(int p_updates);
+        int get_split_screen_updates_per_frame() const;
+
+        void set_split_screen_pixel_budget(int64_t p_pixels);
+        int64_t get_split_screen_pixel_budget() const;
+
+        void set_split_screen_first_layer(int p_layer);
+        int get_split_screen_first_layer() const;
+
+        void set_camera_cut_distance(double p_distance);
+        double get_camera_cut_distance() const;
+
+        void set_camera_cut_angle(double p_degrees);
+        double get_camera_cut_angle() const;
+
+        void set_use_instance_uniforms(bool p_enable);
+        bool get_use_instance_uniforms() const;
+
+        void set_predictive_camera(bool p_enable);
+        bool get_predictive_camera() const;
+
+        void set_prediction_overscan(double p_fraction);
+        double get_prediction_overscan() const;
+
+        void set_lazy_rig_allocation(bool p_lazy);
+        bool get_lazy_rig_allocation() const;
+
+        void set_rig_release_timeout(double p_seconds);
+        double get_rig_release_timeout() const;
+
+        void set_prewarm_on_ready(bool p_enable);
+        bool get_prewarm_on_ready() const;
     };
 
 }
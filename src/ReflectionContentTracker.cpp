@@ -0,0 +1,236 @@
+/**
+ * @file ReflectionContentTracker.cpp
+ * @brief Shared scene change detection for static reflections
+ */
+
+#include "ReflectionContentTracker.h"
+#include "PlanarReflectorCPP.h"
+
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/geometry_instance3d.hpp>
+#include <godot_cpp/classes/light3d.hpp>
+#include <godot_cpp/classes/visual_instance3d.hpp>
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/templates/hashfuncs.hpp>
+
+using namespace godot;
+
+/**
+ * @brief Registers every light and geometry node below the scene root
+ *
+ * Nodes added later are reported by the owner through add_node.
+ */
+void ReflectionContentTracker::start(Node *p_scene_root)
+{
+    stop();
+    started = true;
+    if (!p_scene_root) {
+        return;
+    }
+    scene_root_id = p_scene_root->get_instance_id();
+    collect_nodes(p_scene_root);
+}
+
+/**
+ * @brief Forgets all nodes - the log keeps its sequence numbers so old cursors stay comparable
+ */
+void ReflectionContentTracker::stop()
+{
+    nodes.clear();
+    node_ids.clear();
+    log_base = get_log_end();
+    log.clear();
+    scene_root_id = 0;
+    started = false;
+}
+
+/**
+ * @brief Whether a node lies below the scene root the tracker watches
+ */
+bool ReflectionContentTracker::is_in_scene(Node *p_node) const
+{
+    Node *root = Object::cast_to<Node>(ObjectDB::get_instance(scene_root_id));
+    return root && p_node && (p_node == root || root->is_ancestor_of(p_node));
+}
+
+/**
+ * @brief Lights and geometry are watched automatically - reflectors filter by their layers
+ */
+bool ReflectionContentTracker::is_auto_trackable(Node *p_node)
+{
+    return Object::cast_to<Light3D>(p_node) || Object::cast_to<GeometryInstance3D>(p_node);
+}
+
+void ReflectionContentTracker::collect_nodes(Node *p_node)
+{
+    if (is_auto_trackable(p_node)) {
+        add_node(Object::cast_to<Node3D>(p_node));
+    }
+
+    for (int i = 0; i < p_node->get_child_count(); i++) {
+        collect_nodes(p_node->get_child(i));
+    }
+}
+
+/**
+ * @brief Starts watching a node; its first poll is reported as a change
+ */
+void ReflectionContentTracker::add_node(Node3D *p_node)
+{
+    if (!p_node || node_ids.has(p_node->get_instance_id())) {
+        return;
+    }
+
+    TrackedNode tracked;
+    tracked.instance_id = p_node->get_instance_id();
+    tracked.is_light = Object::cast_to<Light3D>(p_node) != nullptr;
+    for (Node *node = p_node; node; node = node->get_parent()) {
+        if (Object::cast_to<PlanarReflectorCPP>(node)) {
+            tracked.reflector_id = node->get_instance_id();
+            break;
+        }
+    }
+
+    nodes.push_back(tracked);
+    node_ids.insert(tracked.instance_id);
+}
+
+/**
+ * @brief Stops watching a node and logs its disappearance
+ */
+void ReflectionContentTracker::remove_node(uint64_t p_instance_id)
+{
+    if (!node_ids.has(p_instance_id)) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < nodes.size(); i++) {
+        const TrackedNode &tracked = nodes[i];
+        if (tracked.instance_id != p_instance_id) {
+            continue;
+        }
+
+        if (!tracked.is_new) {
+            Change change;
+            change.instance_id = tracked.instance_id;
+            change.reflector_id = tracked.reflector_id;
+            change.is_light = tracked.is_light;
+            change.layer_mask = tracked.last_layer_mask;
+            change.was_visible = tracked.last_visible;
+            change.old_world_aabb = tracked.last_world_aabb;
+            log.push_back(change);
+        }
+        nodes.remove_at_unordered(i);
+        break;
+    }
+    node_ids.erase(p_instance_id);
+}
+
+/**
+ * @brief Compares every watched node against its last state (once per frame)
+ */
+void ReflectionContentTracker::poll()
+{
+    uint64_t frame = Engine::get_singleton()->get_process_frames();
+    if (frame == last_poll_frame) {
+        return;
+    }
+    last_poll_frame = frame;
+
+    for (uint32_t i = 0; i < nodes.size();) {
+        TrackedNode &tracked = nodes[i];
+        Node3D *node = Object::cast_to<Node3D>(ObjectDB::get_instance(tracked.instance_id));
+
+        // Freed without a node_removed notification
+        if (!node) {
+            remove_node(tracked.instance_id);
+            continue;
+        }
+
+        if (!node->is_inside_tree()) {
+            i++;
+            continue;
+        }
+
+        Transform3D current_transform = node->get_global_transform();
+        bool current_visible = node->is_visible_in_tree();
+        GeometryInstance3D *geometry = Object::cast_to<GeometryInstance3D>(node);
+        uint32_t layer_mask = geometry ? geometry->get_layer_mask() : 0;
+        uint32_t light_state = tracked.is_light ? compute_light_state(node) : 0;
+
+        if (!tracked.is_new && current_visible == tracked.last_visible && layer_mask == tracked.last_layer_mask &&
+                light_state == tracked.last_light_state && current_transform.is_equal_approx(tracked.last_transform)) {
+            i++;
+            continue;
+        }
+
+        VisualInstance3D *visual = Object::cast_to<VisualInstance3D>(node);
+        AABB world_aabb = visual ? current_transform.xform(visual->get_aabb()) : AABB(current_transform.origin, Vector3());
+
+        Change change;
+        change.instance_id = tracked.instance_id;
+        change.reflector_id = tracked.reflector_id;
+        change.is_light = tracked.is_light;
+        change.layer_mask = layer_mask | tracked.last_layer_mask;
+        change.was_visible = !tracked.is_new && tracked.last_visible;
+        change.old_world_aabb = tracked.last_world_aabb;
+        change.is_visible = current_visible;
+        change.new_world_aabb = world_aabb;
+        log.push_back(change);
+
+        tracked.last_transform = current_transform;
+        tracked.last_world_aabb = world_aabb;
+        tracked.last_visible = current_visible;
+        tracked.last_layer_mask = layer_mask;
+        tracked.last_light_state = light_state;
+        tracked.is_new = false;
+        i++;
+    }
+}
+
+/**
+ * @brief Drops entries every reader has consumed, and the oldest ones past MAX_LOG_SIZE
+ *
+ * @param p_oldest_cursor Smallest cursor among the reflectors reading the log
+ */
+void ReflectionContentTracker::trim_log(uint64_t p_oldest_cursor)
+{
+    uint64_t drop = MIN(MAX(p_oldest_cursor, log_base), get_log_end()) - log_base;
+    if (log.size() - drop > MAX_LOG_SIZE) {
+        drop = log.size() - MAX_LOG_SIZE;
+    }
+    if (drop == 0) {
+        return;
+    }
+
+    for (uint32_t i = drop; i < log.size(); i++) {
+        log[i - drop] = log[i];
+    }
+    log.resize(log.size() - drop);
+    log_base += drop;
+}
+
+/**
+ * @brief Hash of the light parameters that change what a reflection shows
+ *
+ * The transform and visibility are compared separately. Values are mixed
+ * straight into the hash - this runs for every light on every poll.
+ */
+uint32_t ReflectionContentTracker::compute_light_state(Node3D *p_node)
+{
+    static const Light3D::Param params[6] = { Light3D::PARAM_ENERGY, Light3D::PARAM_INDIRECT_ENERGY, Light3D::PARAM_RANGE,
+        Light3D::PARAM_ATTENUATION, Light3D::PARAM_SPOT_ANGLE, Light3D::PARAM_SPOT_ATTENUATION };
+
+    Light3D *light = Object::cast_to<Light3D>(p_node);
+    Color color = light->get_color();
+    uint32_t hash = hash_murmur3_one_float(color.r);
+    hash = hash_murmur3_one_float(color.g, hash);
+    hash = hash_murmur3_one_float(color.b, hash);
+    hash = hash_murmur3_one_float(color.a, hash);
+    for (int i = 0; i < 6; i++) {
+        hash = hash_murmur3_one_float(light->get_param(params[i]), hash);
+    }
+    hash = hash_murmur3_one_32((light->has_shadow() ? 1u : 0u) | (light->is_negative() ? 2u : 0u), hash);
+    hash = hash_murmur3_one_32(light->get_cull_mask(), hash);
+    return hash_fmix32(hash);
+}
@@ -0,0 +1,84 @@
+#ifndef REFLECTION_CONTENT_TRACKER_H
+#define REFLECTION_CONTENT_TRACKER_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/aabb.hpp>
+#include <godot_cpp/variant/transform3d.hpp>
+
+namespace godot {
+
+    /**
+     * @brief Scene content watcher shared by every "static until changed" reflector
+     *
+     * One tree walk registers the scene's lights and geometry, and one poll
+     * per frame compares each node against its last state. Changes are
+     * appended to a log that every reflector reads from its own cursor, so
+     * per frame the cost is one compare per node, plus one frustum test per
+     * changed node and reflector.
+     */
+    class ReflectionContentTracker
+    {
+    public:
+        struct TrackedNode {
+            uint64_t instance_id = 0;
+            uint64_t reflector_id = 0;      // Nearest PlanarReflectorCPP at or above the node, 0 if none
+            bool is_light = false;
+            bool is_new = true;
+            Transform3D last_transform = Transform3D();
+            AABB last_world_aabb = AABB();
+            bool last_visible = false;
+            uint32_t last_layer_mask = 0;   // Geometry render layers, 0 for lights and plain nodes
+            uint32_t last_light_state = 0;  // Hash of every light parameter that changes the lighting
+        };
+
+        struct Change {
+            uint64_t instance_id = 0;
+            uint64_t reflector_id = 0;
+            bool is_light = false;
+            uint32_t layer_mask = 0;        // Old and new layers combined
+            bool was_visible = false;       // False for newly tracked nodes
+            AABB old_world_aabb = AABB();
+            bool is_visible = false;        // False for freed or removed nodes
+            AABB new_world_aabb = AABB();
+        };
+
+        static const uint32_t MAX_LOG_SIZE = 4096;  // Readers further behind re-render instead
+
+        void start(Node *p_scene_root);
+        void stop();
+        bool is_started() const { return started; }
+        bool is_in_scene(Node *p_node) const;
+        static bool is_auto_trackable(Node *p_node);
+
+        void add_node(Node3D *p_node);
+        void remove_node(uint64_t p_instance_id);
+        void poll();
+
+        uint32_t get_node_count() const { return nodes.size(); }
+        const TrackedNode &get_node(uint32_t p_index) const { return nodes[p_index]; }
+
+        // Change log - sequence numbers grow forever, old entries are trimmed
+        uint64_t get_log_end() const { return log_base + log.size(); }
+        bool is_cursor_valid(uint64_t p_cursor) const { return p_cursor >= log_base; }
+        const Change &get_change(uint64_t p_sequence) const { return log[p_sequence - log_base]; }
+        void trim_log(uint64_t p_oldest_cursor);
+
+    private:
+        void collect_nodes(Node *p_node);
+        static uint32_t compute_light_state(Node3D *p_node);
+
+        LocalVector<TrackedNode> nodes;
+        HashSet<uint64_t> node_ids;
+        LocalVector<Change> log;
+        uint64_t log_base = 0;
+        uint64_t scene_root_id = 0;
+        uint64_t last_poll_frame = UINT64_MAX;
+        bool started = false;
+    };
+
+}
+
+#endif // REFLECTION_CONTENT_TRACKER_H
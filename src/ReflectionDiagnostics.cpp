@@ -0,0 +1,158 @@
+/**
+ * @file ReflectionDiagnostics.cpp
+ * @brief Rate-limited diagnostics shared by all PlanarReflectorCPP instances
+ */
+
+#include "ReflectionDiagnostics.h"
+
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+using namespace godot;
+
+ReflectionDiagnostics::Event ReflectionDiagnostics::ring[ReflectionDiagnostics::RING_SIZE];
+std::atomic<uint64_t> ReflectionDiagnostics::write_index{0};
+std::atomic<uint64_t> ReflectionDiagnostics::counters[REFLECTION_DIAG_CODE_MAX];
+std::atomic<uint64_t> ReflectionDiagnostics::last_print_usec[REFLECTION_DIAG_CODE_MAX];
+std::atomic<uint64_t> ReflectionDiagnostics::suppressed[REFLECTION_DIAG_CODE_MAX];
+std::atomic<bool> ReflectionDiagnostics::print_enabled{true};
+std::atomic<uint64_t> ReflectionDiagnostics::print_interval_usec{1000000};  // One line per code per second
+
+/**
+ * @brief Records a diagnostic event and prints it if the code's rate limit allows
+ * 
+ * @param code What went wrong
+ * @param reflector_id Instance id of the reporting reflector (0 if none)
+ * @param detail Human-readable message for the print sink - only turned into a String when printed
+ */
+void ReflectionDiagnostics::report(ReflectionDiagnosticCode code, uint64_t reflector_id, const char *detail)
+{
+    if (code < 0 || code >= REFLECTION_DIAG_CODE_MAX) {
+        return;
+    }
+
+    uint64_t now = Time::get_singleton()->get_ticks_usec();
+    counters[code].fetch_add(1, std::memory_order_relaxed);
+
+    // Claim a slot; readers skip it until the sequence is published
+    uint64_t index = write_index.fetch_add(1, std::memory_order_relaxed);
+    Event &event = ring[index % RING_SIZE];
+    event.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);  // Readers seeing the new fields also see the 0
+    event.code.store((uint32_t)code, std::memory_order_relaxed);
+    event.reflector_id.store(reflector_id, std::memory_order_relaxed);
+    event.time_usec.store(now, std::memory_order_relaxed);
+    event.sequence.store(index + 1, std::memory_order_release);
+
+    if (!print_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // One winner per interval prints; everyone else is counted as suppressed
+    uint64_t last = last_print_usec[code].load(std::memory_order_relaxed);
+    if (last != 0 && now - last < print_interval_usec.load(std::memory_order_relaxed)) {
+        suppressed[code].fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (!last_print_usec[code].compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+        suppressed[code].fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    uint64_t repeats = suppressed[code].exchange(0, std::memory_order_relaxed);
+    if (repeats > 0) {
+        UtilityFunctions::print("[PlanarReflectorCPP] ", String(detail), " (", (int64_t)repeats, " similar messages suppressed)");
+    } else {
+        UtilityFunctions::print("[PlanarReflectorCPP] ", String(detail));
+    }
+}
+
+/**
+ * @brief Total reports per code since start (or the last clear), keyed by code name
+ */
+Dictionary ReflectionDiagnostics::get_counts()
+{
+    Dictionary counts;
+    for (int i = 0; i < REFLECTION_DIAG_CODE_MAX; i++) {
+        counts[get_code_name(i)] = (int64_t)counters[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+/**
+ * @brief Most recent events, newest first
+ * 
+ * Each entry is a Dictionary with code, name, reflector_id and time_usec.
+ * Slots being overwritten while reading are skipped.
+ * 
+ * @param max_events Upper bound on returned events (capped at RING_SIZE)
+ */
+Array ReflectionDiagnostics::get_recent(int max_events)
+{
+    Array events;
+    uint64_t end = write_index.load(std::memory_order_acquire);
+    uint64_t count = (uint64_t)(max_events < RING_SIZE ? (max_events > 0 ? max_events : 0) : RING_SIZE);
+    count = count < end ? count : end;
+
+    for (uint64_t n = 0; n < count; n++) {
+        uint64_t index = end - 1 - n;
+        Event &event = ring[index % RING_SIZE];
+
+        uint64_t sequence = event.sequence.load(std::memory_order_acquire);
+        uint32_t code = event.code.load(std::memory_order_relaxed);
+        uint64_t reflector_id = event.reflector_id.load(std::memory_order_relaxed);
+        uint64_t time_usec = event.time_usec.load(std::memory_order_relaxed);
+
+        // Written by a newer report while we were reading - drop it
+        std::atomic_thread_fence(std::memory_order_acquire);  // Field loads above stay before the re-check
+        if (sequence != index + 1 || event.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+
+        Dictionary entry;
+        entry["code"] = (int64_t)code;
+        entry["name"] = get_code_name((int)code);
+        entry["reflector_id"] = (int64_t)reflector_id;
+        entry["time_usec"] = (int64_t)time_usec;
+        events.push_back(entry);
+    }
+    return events;
+}
+
+/**
+ * @brief Resets counters, rate limits and the event ring
+ */
+void ReflectionDiagnostics::clear()
+{
+    for (int i = 0; i < REFLECTION_DIAG_CODE_MAX; i++) {
+        counters[i].store(0, std::memory_order_relaxed);
+        last_print_usec[i].store(0, std::memory_order_relaxed);
+        suppressed[i].store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < RING_SIZE; i++) {
+        ring[i].sequence.store(0, std::memory_order_relaxed);
+    }
+    write_index.store(0, std::memory_order_release);
+}
+
+void ReflectionDiagnostics::set_print_enabled(bool p_enabled) { print_enabled.store(p_enabled, std::memory_order_relaxed); }
+bool ReflectionDiagnostics::is_print_enabled() { return print_enabled.load(std::memory_order_relaxed); }
+
+void ReflectionDiagnostics::set_print_interval(double p_seconds)
+{
+    double seconds = p_seconds > 0.0 ? p_seconds : 0.0;
+    print_interval_usec.store((uint64_t)(seconds * 1000000.0), std::memory_order_relaxed);
+}
+
+double ReflectionDiagnostics::get_print_interval() { return (double)print_interval_usec.load(std::memory_order_relaxed) / 1000000.0; }
+
+String ReflectionDiagnostics::get_code_name(int code)
+{
+    switch (code) {
+        case REFLECTION_DIAG_MISSING_CAMERA: return "missing_camera";
+        case REFLECTION_DIAG_INVALID_TEXTURE: return "invalid_texture";
+        case REFLECTION_DIAG_NULL_VIEWPORT: return "null_viewport";
+        case REFLECTION_DIAG_INVALID_ENVIRONMENT: return "invalid_environment";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef REFLECTION_DIAGNOSTICS_H
+#define REFLECTION_DIAGNOSTICS_H
+
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace godot {
+
+    /**
+     * @brief Diagnostic event codes reported by planar reflectors
+     */
+    enum ReflectionDiagnosticCode {
+        REFLECTION_DIAG_MISSING_CAMERA = 0,     // No main/editor camera or reflection camera yet
+        REFLECTION_DIAG_INVALID_TEXTURE,        // Reflection texture missing or not matching the viewport
+        REFLECTION_DIAG_NULL_VIEWPORT,          // Viewport work requested before the rig exists
+        REFLECTION_DIAG_INVALID_ENVIRONMENT,    // Custom environment cleared or invalid
+        REFLECTION_DIAG_CODE_MAX
+    };
+
+    /**
+     * @brief Process-wide, rate-limited diagnostics for the reflection hot path
+     * 
+     * Every report bumps a per-code counter and lands in a lock-free ring
+     * buffer of recent events. Printing is an optional sink, limited to one
+     * line per code per print interval, with the number of suppressed
+     * repeats appended. Safe to call from any thread.
+     */
+    class ReflectionDiagnostics
+    {
+    public:
+        static const int RING_SIZE = 256;
+
+        static void report(ReflectionDiagnosticCode code, uint64_t reflector_id, const char *detail);
+
+        static Dictionary get_counts();
+        static Array get_recent(int max_events);
+        static void clear();
+
+        static void set_print_enabled(bool p_enabled);
+        static bool is_print_enabled();
+        static void set_print_interval(double p_seconds);
+        static double get_print_interval();
+
+        static String get_code_name(int code);
+
+    private:
+        struct Event {
+            std::atomic<uint64_t> sequence{0};  // index + 1 once written, 0 while being written
+            std::atomic<uint32_t> code{0};
+            std::atomic<uint64_t> reflector_id{0};
+            std::atomic<uint64_t> time_usec{0};
+        };
+
+        static Event ring[RING_SIZE];
+        static std::atomic<uint64_t> write_index;
+        static std::atomic<uint64_t> counters[REFLECTION_DIAG_CODE_MAX];
+        static std::atomic<uint64_t> last_print_usec[REFLECTION_DIAG_CODE_MAX];
+        static std::atomic<uint64_t> suppressed[REFLECTION_DIAG_CODE_MAX];
+        static std::atomic<bool> print_enabled;
+        static std::atomic<uint64_t> print_interval_usec;
+    };
+
+}
+
+#endif // REFLECTION_DIAGNOSTICS_H
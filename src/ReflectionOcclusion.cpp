@@ -0,0 +1,278 @@
+/**
+ * @file ReflectionOcclusion.cpp
+ * @brief Software depth buffer used to skip reflectors hidden behind occluders
+ */
+
+#include "ReflectionOcclusion.h"
+
+#include <godot_cpp/classes/mesh.hpp>
+#include <godot_cpp/classes/mesh_instance3d.hpp>
+#include <godot_cpp/classes/occluder3d.hpp>
+#include <godot_cpp/classes/occluder_instance3d.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/core/math.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+
+#include <cmath>
+
+using namespace godot;
+
+static constexpr float OCCLUSION_MIN_W = 0.001f;  // Points this close to the eye plane are not projected
+
+/**
+ * @brief Clears the buffer for a new camera
+ *
+ * @param p_view_projection Camera projection times the inverse camera transform
+ * @param p_width Buffer width in pixels
+ * @param p_height Buffer height in pixels
+ */
+void ReflectionOcclusionBuffer::begin(const Projection &p_view_projection, int p_width, int p_height)
+{
+    view_projection = p_view_projection;
+    width = MAX(p_width, 1);
+    height = MAX(p_height, 1);
+    triangle_count = 0;
+
+    depth.resize(width * height);
+    for (uint32_t i = 0; i < depth.size(); i++) {
+        depth[i] = INFINITY;
+    }
+}
+
+/**
+ * @brief Rasterizes an indexed triangle mesh (Occluder3D layout)
+ */
+void ReflectionOcclusionBuffer::add_indexed_triangles(const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices, const Transform3D &p_xform)
+{
+    int vertex_count = p_vertices.size();
+    for (int i = 0; i + 2 < p_indices.size(); i += 3) {
+        int a = p_indices[i];
+        int b = p_indices[i + 1];
+        int c = p_indices[i + 2];
+        if (a < 0 || b < 0 || c < 0 || a >= vertex_count || b >= vertex_count || c >= vertex_count) {
+            continue;
+        }
+        rasterize_triangle(p_vertices[a], p_vertices[b], p_vertices[c], p_xform);
+    }
+}
+
+/**
+ * @brief Rasterizes a flat triangle list (Mesh::get_faces layout)
+ */
+void ReflectionOcclusionBuffer::add_triangle_list(const PackedVector3Array &p_faces, const Transform3D &p_xform)
+{
+    for (int i = 0; i + 2 < p_faces.size(); i += 3) {
+        rasterize_triangle(p_faces[i], p_faces[i + 1], p_faces[i + 2], p_xform);
+    }
+}
+
+/**
+ * @brief Rasterizes an OccluderInstance3D's occluder or a MeshInstance3D's faces
+ *
+ * Mesh faces are extracted once per mesh and kept in r_face_cache, since
+ * Mesh::get_faces builds a new array on every call.
+ */
+void ReflectionOcclusionBuffer::add_occluder_node(Node3D *p_node, HashMap<uint64_t, PackedVector3Array> &r_face_cache)
+{
+    OccluderInstance3D *occluder_instance = Object::cast_to<OccluderInstance3D>(p_node);
+    if (occluder_instance) {
+        Ref<Occluder3D> occluder = occluder_instance->get_occluder();
+        if (occluder.is_valid()) {
+            add_indexed_triangles(occluder->get_vertices(), occluder->get_indices(), occluder_instance->get_global_transform());
+        }
+        return;
+    }
+
+    MeshInstance3D *mesh_instance = Object::cast_to<MeshInstance3D>(p_node);
+    Ref<Mesh> mesh = mesh_instance ? mesh_instance->get_mesh() : Ref<Mesh>();
+    if (mesh.is_null()) {
+        return;
+    }
+    uint64_t mesh_id = mesh->get_instance_id();
+    if (!r_face_cache.has(mesh_id)) {
+        r_face_cache.insert(mesh_id, mesh->get_faces());
+    }
+    add_triangle_list(r_face_cache[mesh_id], mesh_instance->get_global_transform());
+}
+
+/**
+ * @brief Finds the occluders below a root: OccluderInstance3D nodes and OCCLUDER_GROUP meshes
+ */
+void ReflectionOcclusionBuffer::collect_occluder_nodes(Node *p_root, LocalVector<uint64_t> &r_node_ids)
+{
+    r_node_ids.clear();
+    if (!p_root || !p_root->is_inside_tree()) {
+        return;
+    }
+
+    TypedArray<Node> occluder_instances = p_root->find_children("*", "OccluderInstance3D", true, false);
+    for (int i = 0; i < occluder_instances.size(); i++) {
+        Object *node = occluder_instances[i];
+        r_node_ids.push_back(node->get_instance_id());
+    }
+
+    TypedArray<Node> occluder_meshes = p_root->get_tree()->get_nodes_in_group(OCCLUDER_GROUP);
+    for (int i = 0; i < occluder_meshes.size(); i++) {
+        Node *node = Object::cast_to<Node>(occluder_meshes[i]);
+        if (Object::cast_to<MeshInstance3D>(node) && (node == p_root || p_root->is_ancestor_of(node))) {
+            r_node_ids.push_back(node->get_instance_id());
+        }
+    }
+}
+
+/**
+ * @brief Writes one triangle's nearest depth into the covered pixels
+ *
+ * Both sides are rasterized - occluders are often single planes. Depth is
+ * interpolated as 1/w, which is linear in screen space. Coverage is
+ * conservative: a pixel is written only if all four of its corners lie in
+ * the triangle, and it gets the farthest corner depth, so a partly covered
+ * or sloped pixel can never hide more than the occluder really does.
+ */
+void ReflectionOcclusionBuffer::rasterize_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c, const Transform3D &p_xform)
+{
+    const Vector3 world[3] = { p_xform.xform(p_a), p_xform.xform(p_b), p_xform.xform(p_c) };
+    float sx[3];
+    float sy[3];
+    float inv_w[3];
+
+    for (int i = 0; i < 3; i++) {
+        Vector4 clip = view_projection.xform(Vector4(world[i].x, world[i].y, world[i].z, 1.0));
+        if (clip.w < OCCLUSION_MIN_W) {
+            return;  // Crosses the near plane - skipping only loses occlusion, never adds it
+        }
+        inv_w[i] = 1.0f / (float)clip.w;
+        sx[i] = ((float)clip.x * inv_w[i] * 0.5f + 0.5f) * (float)width;
+        sy[i] = (0.5f - (float)clip.y * inv_w[i] * 0.5f) * (float)height;
+    }
+
+    float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+    if (Math::abs(area) < 1e-6f) {
+        return;
+    }
+    triangle_count++;
+
+    int min_x = MAX((int)Math::floor(MIN(sx[0], MIN(sx[1], sx[2]))), 0);
+    int max_x = MIN((int)Math::ceil(MAX(sx[0], MAX(sx[1], sx[2]))), width - 1);
+    int min_y = MAX((int)Math::floor(MIN(sy[0], MIN(sy[1], sy[2]))), 0);
+    int max_y = MIN((int)Math::ceil(MAX(sy[0], MAX(sy[1], sy[2]))), height - 1);
+    float inv_area = 1.0f / area;
+
+    for (int y = min_y; y <= max_y; y++) {
+        for (int x = min_x; x <= max_x; x++) {
+            float pixel_depth = 0.0f;
+            bool covered = true;
+
+            for (int corner = 0; corner < 4; corner++) {
+                float px = (float)(x + (corner & 1));
+                float py = (float)(y + (corner >> 1));
+
+                // Barycentric weights of the pixel corner (sign-normalized by the area)
+                float w0 = ((sx[1] - px) * (sy[2] - py) - (sx[2] - px) * (sy[1] - py)) * inv_area;
+                float w1 = ((sx[2] - px) * (sy[0] - py) - (sx[0] - px) * (sy[2] - py)) * inv_area;
+                float w2 = 1.0f - w0 - w1;
+                if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+                    covered = false;
+                    break;
+                }
+                pixel_depth = MAX(pixel_depth, 1.0f / (w0 * inv_w[0] + w1 * inv_w[1] + w2 * inv_w[2]));
+            }
+            if (!covered) {
+                continue;
+            }
+
+            float &stored = depth[y * width + x];
+            if (pixel_depth < stored) {
+                stored = pixel_depth;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Whether the bounds are hidden behind rasterized occluders
+ *
+ * @param p_world_bounds World-space bounds of the reflector
+ * @param p_margin_pixels Grows the tested rectangle - used for early reveal
+ * @return bool True only if every pixel of the (grown) rectangle is covered by a nearer occluder
+ */
+bool ReflectionOcclusionBuffer::is_occluded(const AABB &p_world_bounds, int p_margin_pixels) const
+{
+    if (triangle_count == 0) {
+        return false;
+    }
+
+    float min_x = INFINITY;
+    float max_x = -INFINITY;
+    float min_y = INFINITY;
+    float max_y = -INFINITY;
+    float nearest = INFINITY;
+
+    for (int i = 0; i < 8; i++) {
+        Vector3 corner = p_world_bounds.get_endpoint(i);
+        Vector4 clip = view_projection.xform(Vector4(corner.x, corner.y, corner.z, 1.0));
+        if (clip.w < OCCLUSION_MIN_W) {
+            return false;  // Bounds reach the camera - treat as visible
+        }
+        float inv_w = 1.0f / (float)clip.w;
+        float sx = ((float)clip.x * inv_w * 0.5f + 0.5f) * (float)width;
+        float sy = (0.5f - (float)clip.y * inv_w * 0.5f) * (float)height;
+        min_x = MIN(min_x, sx);
+        max_x = MAX(max_x, sx);
+        min_y = MIN(min_y, sy);
+        max_y = MAX(max_y, sy);
+        nearest = MIN(nearest, (float)clip.w);
+    }
+
+    int x0 = MAX((int)Math::floor(min_x) - p_margin_pixels, 0);
+    int x1 = MIN((int)Math::ceil(max_x) + p_margin_pixels, width - 1);
+    int y0 = MAX((int)Math::floor(min_y) - p_margin_pixels, 0);
+    int y1 = MIN((int)Math::ceil(max_y) + p_margin_pixels, height - 1);
+    if (x0 > x1 || y0 > y1) {
+        return false;  // Off screen - frustum visibility decides, not occlusion
+    }
+
+    float limit = nearest - DEPTH_BIAS;
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            if (depth[y * width + x] >= limit) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Fraction of the screen covered by the bounds' projected rectangle
+ *
+ * @return float 0 when off screen, 1 when the bounds reach the camera
+ */
+float ReflectionOcclusionBuffer::get_screen_coverage(const AABB &p_world_bounds) const
+{
+    float min_x = INFINITY;
+    float max_x = -INFINITY;
+    float min_y = INFINITY;
+    float max_y = -INFINITY;
+
+    for (int i = 0; i < 8; i++) {
+        Vector3 corner = p_world_bounds.get_endpoint(i);
+        Vector4 clip = view_projection.xform(Vector4(corner.x, corner.y, corner.z, 1.0));
+        if (clip.w < OCCLUSION_MIN_W) {
+            return 1.0f;
+        }
+        float ndc_x = (float)(clip.x / clip.w);
+        float ndc_y = (float)(clip.y / clip.w);
+        min_x = MIN(min_x, ndc_x);
+        max_x = MAX(max_x, ndc_x);
+        min_y = MIN(min_y, ndc_y);
+        max_y = MAX(max_y, ndc_y);
+    }
+
+    float covered_x = MIN(max_x, 1.0f) - MAX(min_x, -1.0f);
+    float covered_y = MIN(max_y, 1.0f) - MAX(min_y, -1.0f);
+    if (covered_x <= 0.0f || covered_y <= 0.0f) {
+        return 0.0f;
+    }
+    return covered_x * covered_y * 0.25f;  // NDC square is 2 x 2
+}
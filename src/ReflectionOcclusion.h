@@ -0,0 +1,57 @@
+#ifndef REFLECTION_OCCLUSION_H
+#define REFLECTION_OCCLUSION_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/aabb.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/projection.hpp>
+#include <godot_cpp/variant/transform3d.hpp>
+#include <godot_cpp/variant/vector4.hpp>
+
+namespace godot {
+
+    /**
+     * @brief Small CPU depth buffer for occlusion-testing reflector bounds
+     *
+     * Occluder triangles are rasterized at low resolution with linear view
+     * depth. Triangles crossing the near plane are dropped rather than
+     * clipped, so the buffer can only under-report occlusion. A query
+     * reports occluded only when every pixel of the bounds' screen
+     * rectangle holds an occluder nearer than the bounds' nearest point.
+     */
+    class ReflectionOcclusionBuffer
+    {
+    public:
+        static constexpr int DEFAULT_WIDTH = 128;
+        static constexpr int DEFAULT_HEIGHT = 64;
+        static constexpr float DEPTH_BIAS = 0.1f;   // World units an occluder must be in front by
+
+        void begin(const Projection &p_view_projection, int p_width = DEFAULT_WIDTH, int p_height = DEFAULT_HEIGHT);
+        void add_indexed_triangles(const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices, const Transform3D &p_xform);
+        void add_triangle_list(const PackedVector3Array &p_faces, const Transform3D &p_xform);
+        void add_occluder_node(Node3D *p_node, HashMap<uint64_t, PackedVector3Array> &r_face_cache);
+
+        bool is_occluded(const AABB &p_world_bounds, int p_margin_pixels) const;
+        float get_screen_coverage(const AABB &p_world_bounds) const;
+        bool has_occluders() const { return triangle_count > 0; }
+
+        static constexpr const char *OCCLUDER_GROUP = "reflection_occluders";
+        static void collect_occluder_nodes(Node *p_root, LocalVector<uint64_t> &r_node_ids);
+
+    private:
+        void rasterize_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c, const Transform3D &p_xform);
+
+        Projection view_projection;
+        LocalVector<float> depth;   // Linear view depth per pixel, INFINITY where no occluder
+        int width = 0;
+        int height = 0;
+        int triangle_count = 0;
+    };
+
+}
+
+#endif // REFLECTION_OCCLUSION_H
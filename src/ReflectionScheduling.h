@@ -0,0 +1,65 @@
+#ifndef REFLECTION_SCHEDULING_H
+#define REFLECTION_SCHEDULING_H
+
+/**
+ * @file ReflectionScheduling.h
+ * @brief Engine-independent scheduling and resolution math used by PlanarReflectorCPP
+ * 
+ * Kept free of godot-cpp types so the offline trace replay tool
+ * (tools/reflection_replay) runs exactly the same decisions as the extension.
+ */
+
+#include <cstdint>
+
+namespace ReflectionScheduling {
+
+    /**
+     * @brief Whether the throttled reflection update runs on this reflector frame
+     */
+    inline bool is_update_frame(uint64_t frame, int update_frequency)
+    {
+        return update_frequency > 0 && frame % (uint64_t)update_frequency == 0;
+    }
+
+    /**
+     * @brief Distance-based resolution factor between 1.0 (near) and far_multiplier (far)
+     */
+    inline double lod_factor(double distance, double near_distance, double far_distance, double far_multiplier)
+    {
+        if (distance <= near_distance) {
+            return 1.0;  // Full quality
+        }
+
+        // Interpolate between full quality (1.0) and reduced quality
+        double lerp_factor = (distance - near_distance) / (far_distance - near_distance);
+        lerp_factor = lerp_factor < 0.0 ? 0.0 : (lerp_factor > 1.0 ? 1.0 : lerp_factor);
+        return 1.0 + (far_multiplier - 1.0) * lerp_factor;
+    }
+
+    /**
+     * @brief Resolution factor for a blurred reflection
+     * 
+     * The blur kernel grows from 1 texel (sharp) to 1/min_scale texels (fully
+     * rough), so resolution shrinks by the kernel width.
+     */
+    inline double roughness_factor(double roughness, double min_scale)
+    {
+        if (roughness <= 0.0) {
+            return 1.0;  // Sharp mirror - keep full resolution
+        }
+        double kernel_width = 1.0 + roughness * (1.0 / min_scale - 1.0);
+        return 1.0 / kernel_width;
+    }
+
+    /**
+     * @brief Scales one edge of the target size and applies the minimum
+     */
+    inline int32_t scale_edge(int32_t edge, double factor, int32_t min_edge)
+    {
+        int32_t scaled = (int32_t)((double)edge * factor);
+        return scaled < min_edge ? min_edge : scaled;
+    }
+
+}
+
+#endif // REFLECTION_SCHEDULING_H
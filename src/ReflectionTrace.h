@@ -0,0 +1,71 @@
+#ifndef REFLECTION_TRACE_H
+#define REFLECTION_TRACE_H
+
+/**
+ * @file ReflectionTrace.h
+ * @brief Binary per-frame trace format written by PlanarReflectorCPP and read by tools/reflection_replay
+ * 
+ * A trace file is one ReflectionTraceHeader followed by one
+ * ReflectionTraceRecord per processed frame, all little-endian. Each
+ * reflector writes its own file, so several files can be replayed together.
+ */
+
+#include <cstdint>
+
+#define REFLECTION_TRACE_MAGIC "PRTR"
+#define REFLECTION_TRACE_VERSION 2
+
+/**
+ * @brief Bits of ReflectionTraceRecord::flags
+ */
+enum ReflectionTraceFlags : uint32_t {
+    REFLECTION_TRACE_VISIBLE = 1 << 0,      // Reflector inside the active camera frustum
+    REFLECTION_TRACE_UPDATED = 1 << 1,      // Reflection camera moved to the current view this frame
+    REFLECTION_TRACE_EVICTED = 1 << 2,      // Targets evicted by the VRAM budget
+    REFLECTION_TRACE_EMPTY = 1 << 3,        // Empty mirror - scene pass skipped
+    REFLECTION_TRACE_CAMERA_CUT = 1 << 4,   // Camera cut forced a refresh
+    REFLECTION_TRACE_RENDERED = 1 << 5,     // A reflection render was drawn (single or continuous)
+    REFLECTION_TRACE_CONTINUOUS = 1 << 6,   // Target renders every frame (UPDATE_ALWAYS)
+};
+
+/**
+ * @brief Settings the recording reflector ran with, replay defaults
+ */
+struct ReflectionTraceHeader {
+    char magic[4];                  // REFLECTION_TRACE_MAGIC
+    uint32_t version;               // REFLECTION_TRACE_VERSION
+    uint32_t record_size;           // sizeof(ReflectionTraceRecord)
+    int32_t update_frequency;
+    int32_t use_lod;
+    int32_t min_size;               // Minimum target edge in pixels
+    float lod_distance_near;
+    float lod_distance_far;
+    float lod_resolution_multiplier;
+    float roughness_min_resolution_scale;
+    uint64_t reflector_id;
+};
+
+/**
+ * @brief What one reflector saw and decided in one processed frame
+ */
+struct ReflectionTraceRecord {
+    uint64_t engine_frame;          // Engine process frame - aligns several traces
+    uint64_t reflector_frame;       // Reflector frame counter the scheduler uses
+    float delta;
+    float camera_position[3];
+    float camera_rotation[4];       // Quaternion x, y, z, w
+    float reflector_position[3];
+    float reflector_normal[3];
+    float roughness;                // Effective roughness used for resolution
+    int32_t base_width;             // Target size before LOD and roughness
+    int32_t base_height;
+    int32_t chosen_width;           // Actual reflection viewport size
+    int32_t chosen_height;
+    uint32_t flags;                 // ReflectionTraceFlags
+    uint32_t update_usec;           // CPU time spent in the reflector this frame
+};
+
+static_assert(sizeof(ReflectionTraceHeader) == 48, "ReflectionTraceHeader layout changed - bump REFLECTION_TRACE_VERSION");
+static_assert(sizeof(ReflectionTraceRecord) == 104, "ReflectionTraceRecord layout changed - bump REFLECTION_TRACE_VERSION");
+
+#endif // REFLECTION_TRACE_H
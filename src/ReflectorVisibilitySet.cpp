@@ -0,0 +1,398 @@
+/**
+ * @file ReflectorVisibilitySet.cpp
+ * @brief Baked per-cell reflector visibility for fixed-layout levels
+ */
+
+#include "ReflectorVisibilitySet.h"
+#include "PlanarReflectorCPP.h"
+#include "ReflectionOcclusion.h"
+
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/math.hpp>
+#include <godot_cpp/variant/basis.hpp>
+#include <godot_cpp/variant/projection.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+using namespace godot;
+
+/**
+ * @brief Grid resolution along each axis (at least one cell)
+ */
+Vector3i ReflectorVisibilitySet::get_cell_counts() const
+{
+    Vector3 size = bounds.size / cell_size;
+    return Vector3i(MAX((int)Math::ceil(size.x), 1), MAX((int)Math::ceil(size.y), 1), MAX((int)Math::ceil(size.z), 1));
+}
+
+int ReflectorVisibilitySet::get_mask_stride() const
+{
+    return (reflector_paths.size() + 7) / 8;
+}
+
+int ReflectorVisibilitySet::get_cell_count() const
+{
+    Vector3i counts = get_cell_counts();
+    return counts.x * counts.y * counts.z;
+}
+
+/**
+ * @brief Whether the masks were baked for the current grid and reflector list
+ */
+bool ReflectorVisibilitySet::has_valid_masks() const
+{
+    return baked_cell_counts == get_cell_counts() && cell_masks.size() == (int64_t)get_cell_count() * get_mask_stride();
+}
+
+/**
+ * @brief Drops the masks after the grid changed - every reflector stays visible until the next bake
+ */
+void ReflectorVisibilitySet::invalidate_masks()
+{
+    cell_masks.clear();
+    baked_cell_counts = Vector3i();
+}
+
+/**
+ * @brief Cell containing a world position
+ *
+ * @return int Cell index, or -1 outside the baked bounds
+ */
+int ReflectorVisibilitySet::get_cell_index(const Vector3 &p_position) const
+{
+    Vector3 local = (p_position - bounds.position) / cell_size;
+    Vector3i counts = get_cell_counts();
+    int x = (int)Math::floor(local.x);
+    int y = (int)Math::floor(local.y);
+    int z = (int)Math::floor(local.z);
+    if (x < 0 || y < 0 || z < 0 || x >= counts.x || y >= counts.y || z >= counts.z) {
+        return -1;
+    }
+    return (z * counts.y + y) * counts.x + x;
+}
+
+/**
+ * @brief Whether a reflector is in a cell's potentially visible set
+ */
+bool ReflectorVisibilitySet::is_reflector_visible(int p_cell, int p_reflector) const
+{
+    int stride = get_mask_stride();
+    int64_t byte_index = (int64_t)p_cell * stride + (p_reflector >> 3);
+    if (p_cell < 0 || p_reflector < 0 || p_reflector >= reflector_paths.size() || !has_valid_masks() || byte_index >= cell_masks.size()) {
+        return true;  // Not covered by the bake - never hide it
+    }
+    return (cell_masks[byte_index] & (1 << (p_reflector & 7))) != 0;
+}
+
+/**
+ * @brief Index of a reflector by its path from the baked scene root, or -1
+ */
+int ReflectorVisibilitySet::find_reflector(const NodePath &p_path) const
+{
+    const int *index = reflector_lookup.getptr(String(p_path));
+    return index ? *index : -1;
+}
+
+/**
+ * @brief The node the set was baked on, looked up from the scene root
+ *
+ * @param p_scene_root Current (or edited) scene root, used for relative paths
+ * @return Node* The baked root, or nullptr if it isn't in this scene
+ */
+Node *ReflectorVisibilitySet::find_bake_root(Node *p_scene_root) const
+{
+    if (!p_scene_root || bake_root_path.is_empty()) {
+        return nullptr;
+    }
+    return p_scene_root->get_node_or_null(bake_root_path);
+}
+
+int ReflectorVisibilitySet::get_reflector_count() const { return reflector_paths.size(); }
+
+double ReflectorVisibilitySet::get_reflector_max_coverage(int p_reflector) const
+{
+    if (p_reflector < 0 || p_reflector >= reflector_max_coverage.size()) {
+        return 0.0;
+    }
+    return reflector_max_coverage[p_reflector];
+}
+
+void ReflectorVisibilitySet::rebuild_reflector_lookup()
+{
+    reflector_lookup.clear();
+    for (int i = 0; i < reflector_paths.size(); i++) {
+        reflector_lookup.insert(reflector_paths[i], i);
+    }
+}
+
+/**
+ * @brief Samples camera positions and records which reflectors each cell can see
+ *
+ * Samples are the cell centers and corners, or p_sample_points (e.g.
+ * navigation mesh vertices raised to eye height) when given. A corner
+ * counts for every cell sharing it, and an explicit point for its own cell
+ * and the cells around it, so a camera anywhere in a cell - not only at
+ * its center - sees what the bake recorded. From every sample the scene
+ * is looked at in six 90 degree directions. A reflector is potentially
+ * visible when its bounds are on screen and not hidden behind
+ * OccluderInstance3D nodes or "reflection_occluders" meshes, using the
+ * same depth buffer as runtime occlusion culling. Cells with no samples of
+ * their own keep every reflector visible.
+ *
+ * The root's path from the current (or edited) scene is stored with the
+ * data, so the set resolves the same reflectors wherever it was baked from.
+ *
+ * @param p_scene_root Root whose PlanarReflectorCPP descendants are baked
+ * @param p_sample_points Optional camera positions instead of cell centers
+ * @return Error OK, or ERR_INVALID_PARAMETER without a root in the tree
+ */
+Error ReflectorVisibilitySet::bake(Node *p_scene_root, const PackedVector3Array &p_sample_points)
+{
+    ERR_FAIL_COND_V_MSG(!p_scene_root || !p_scene_root->is_inside_tree(), ERR_INVALID_PARAMETER, "ReflectorVisibilitySet: bake needs a scene root inside the tree.");
+
+    // The root, by path from the scene it belongs to
+    SceneTree *tree = p_scene_root->get_tree();
+    Node *scene = Engine::get_singleton()->is_editor_hint() ? tree->get_edited_scene_root() : tree->get_current_scene();
+    if (scene && (scene == p_scene_root || scene->is_ancestor_of(p_scene_root))) {
+        bake_root_path = scene->get_path_to(p_scene_root);
+    } else {
+        bake_root_path = p_scene_root->get_path();
+    }
+
+    // Reflectors, identified by path from the root
+    TypedArray<Node> found = p_scene_root->find_children("*", "PlanarReflectorCPP", true, false);
+    LocalVector<PlanarReflectorCPP *> reflectors;
+    reflector_paths.clear();
+    for (int i = 0; i < found.size(); i++) {
+        PlanarReflectorCPP *reflector = Object::cast_to<PlanarReflectorCPP>(found[i]);
+        if (reflector) {
+            reflectors.push_back(reflector);
+            reflector_paths.push_back(String(p_scene_root->get_path_to(reflector)));
+        }
+    }
+
+    LocalVector<uint64_t> occluder_ids;
+    HashMap<uint64_t, PackedVector3Array> face_cache;
+    ReflectionOcclusionBuffer::collect_occluder_nodes(p_scene_root, occluder_ids);
+
+    int cell_count = get_cell_count();
+    int stride = get_mask_stride();
+    PackedByteArray masks;
+    masks.resize((int64_t)cell_count * stride);
+    masks.fill(0);
+    PackedFloat32Array coverage;
+    coverage.resize(reflectors.size());
+    coverage.fill(0.0f);
+
+    // Sample positions and the range of cells each one speaks for
+    Vector3i counts = get_cell_counts();
+    PackedVector3Array samples;
+    LocalVector<Vector3i> sample_first_cell;
+    LocalVector<Vector3i> sample_last_cell;
+    LocalVector<bool> cell_sampled;
+    cell_sampled.resize(cell_count);
+    for (int i = 0; i < cell_count; i++) {
+        cell_sampled[i] = false;
+    }
+    if (p_sample_points.is_empty()) {
+        // Lattice corners, shared by up to eight cells
+        for (int z = 0; z <= counts.z; z++) {
+            for (int y = 0; y <= counts.y; y++) {
+                for (int x = 0; x <= counts.x; x++) {
+                    samples.push_back(bounds.position + Vector3(x, y, z) * cell_size);
+                    sample_first_cell.push_back(Vector3i(x - 1, y - 1, z - 1));
+                    sample_last_cell.push_back(Vector3i(x, y, z));
+                }
+            }
+        }
+        // Cell centers
+        for (int z = 0; z < counts.z; z++) {
+            for (int y = 0; y < counts.y; y++) {
+                for (int x = 0; x < counts.x; x++) {
+                    samples.push_back(bounds.position + (Vector3(x, y, z) + Vector3(0.5, 0.5, 0.5)) * cell_size);
+                    sample_first_cell.push_back(Vector3i(x, y, z));
+                    sample_last_cell.push_back(Vector3i(x, y, z));
+                }
+            }
+        }
+        for (int i = 0; i < cell_count; i++) {
+            cell_sampled[i] = true;
+        }
+    } else {
+        // Explicit points also speak for the neighbouring cells they may not reach
+        for (int s = 0; s < p_sample_points.size(); s++) {
+            int cell = get_cell_index(p_sample_points[s]);
+            if (cell < 0) {
+                continue;
+            }
+            cell_sampled[cell] = true;
+            Vector3i cell_coords(cell % counts.x, (cell / counts.x) % counts.y, cell / (counts.x * counts.y));
+            samples.push_back(p_sample_points[s]);
+            sample_first_cell.push_back(cell_coords - Vector3i(1, 1, 1));
+            sample_last_cell.push_back(cell_coords + Vector3i(1, 1, 1));
+        }
+    }
+    PackedByteArray sample_mask;
+    sample_mask.resize(stride);
+
+    const Vector3 directions[6] = { Vector3(1, 0, 0), Vector3(-1, 0, 0), Vector3(0, 1, 0), Vector3(0, -1, 0), Vector3(0, 0, 1), Vector3(0, 0, -1) };
+    Projection face_projection = Projection::create_perspective(90.0, 1.0, 0.05, bake_far_distance);
+    ReflectionOcclusionBuffer buffer;
+
+    for (int s = 0; s < samples.size(); s++) {
+        sample_mask.fill(0);
+
+        for (int d = 0; d < 6; d++) {
+            Vector3 up = Math::abs(directions[d].y) > 0.5 ? Vector3(0, 0, 1) : Vector3(0, 1, 0);
+            Transform3D eye(Basis::looking_at(directions[d], up), samples[s]);
+            buffer.begin(face_projection * Projection(eye.affine_inverse()), BAKE_BUFFER_SIZE, BAKE_BUFFER_SIZE);
+
+            for (uint32_t o = 0; o < occluder_ids.size(); o++) {
+                Node3D *occluder = Object::cast_to<Node3D>(ObjectDB::get_instance(occluder_ids[o]));
+                if (occluder && occluder->is_visible_in_tree()) {
+                    buffer.add_occluder_node(occluder, face_cache);
+                }
+            }
+
+            for (uint32_t r = 0; r < reflectors.size(); r++) {
+                AABB reflector_bounds = reflectors[r]->get_global_transform().xform(reflectors[r]->get_aabb());
+                if (reflector_bounds.get_center().distance_to(samples[s]) - reflector_bounds.size.length() * 0.5 > bake_far_distance) {
+                    continue;
+                }
+                float screen_fraction = buffer.get_screen_coverage(reflector_bounds);
+                if (screen_fraction <= 0.0f || buffer.is_occluded(reflector_bounds, 0)) {
+                    continue;
+                }
+                sample_mask.set(r >> 3, sample_mask[r >> 3] | (1 << (r & 7)));
+                coverage.set(r, MAX(coverage[r], screen_fraction));
+            }
+        }
+
+        Vector3i first = sample_first_cell[s].max(Vector3i());
+        Vector3i last = sample_last_cell[s].min(counts - Vector3i(1, 1, 1));
+        for (int z = first.z; z <= last.z; z++) {
+            for (int y = first.y; y <= last.y; y++) {
+                for (int x = first.x; x <= last.x; x++) {
+                    int64_t offset = (int64_t)((z * counts.y + y) * counts.x + x) * stride;
+                    for (int b = 0; b < stride; b++) {
+                        masks.set(offset + b, masks[offset + b] | sample_mask[b]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Unsampled cells can't prove anything hidden
+    for (int i = 0; i < cell_count; i++) {
+        if (!cell_sampled[i]) {
+            for (int b = 0; b < stride; b++) {
+                masks.set((int64_t)i * stride + b, 0xFF);
+            }
+        }
+    }
+
+    cell_masks = masks;
+    baked_cell_counts = counts;
+    reflector_max_coverage = coverage;
+    rebuild_reflector_lookup();
+    emit_changed();
+    return OK;
+}
+
+/**
+ * @brief Binds methods and properties to Godot's class system
+ */
+void ReflectorVisibilitySet::_bind_methods()
+{
+    // Grid - Baked region and cell size
+    ClassDB::bind_method(D_METHOD("set_bounds", "p_bounds"), &ReflectorVisibilitySet::set_bounds);
+    ClassDB::bind_method(D_METHOD("get_bounds"), &ReflectorVisibilitySet::get_bounds);
+    ADD_PROPERTY(PropertyInfo(Variant::AABB, "bounds", PROPERTY_HINT_NONE, "World-space region covered by the grid. Cameras outside it see every reflector"), "set_bounds", "get_bounds");
+
+    ClassDB::bind_method(D_METHOD("set_cell_size", "p_size"), &ReflectorVisibilitySet::set_cell_size);
+    ClassDB::bind_method(D_METHOD("get_cell_size"), &ReflectorVisibilitySet::get_cell_size);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size", PROPERTY_HINT_RANGE, "0.25,64.0,0.25", PROPERTY_USAGE_DEFAULT, "Edge length of a grid cell. Changing it invalidates the bake"), "set_cell_size", "get_cell_size");
+
+    ClassDB::bind_method(D_METHOD("set_bake_far_distance", "p_distance"), &ReflectorVisibilitySet::set_bake_far_distance);
+    ClassDB::bind_method(D_METHOD("get_bake_far_distance"), &ReflectorVisibilitySet::get_bake_far_distance);
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bake_far_distance", PROPERTY_HINT_RANGE, "1.0,10000.0,1.0", PROPERTY_USAGE_DEFAULT, "Reflectors further than this from a sample point count as not visible from it"), "set_bake_far_distance", "get_bake_far_distance");
+
+    // Baked data - Stored, not edited by hand
+    ClassDB::bind_method(D_METHOD("set_bake_root_path", "p_path"), &ReflectorVisibilitySet::set_bake_root_path);
+    ClassDB::bind_method(D_METHOD("get_bake_root_path"), &ReflectorVisibilitySet::get_bake_root_path);
+    ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "bake_root_path", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_bake_root_path", "get_bake_root_path");
+
+    ClassDB::bind_method(D_METHOD("set_baked_cell_counts", "p_counts"), &ReflectorVisibilitySet::set_baked_cell_counts);
+    ClassDB::bind_method(D_METHOD("get_baked_cell_counts"), &ReflectorVisibilitySet::get_baked_cell_counts);
+    ADD_PROPERTY(PropertyInfo(Variant::VECTOR3I, "baked_cell_counts", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_baked_cell_counts", "get_baked_cell_counts");
+
+    ClassDB::bind_method(D_METHOD("set_reflector_paths", "p_paths"), &ReflectorVisibilitySet::set_reflector_paths);
+    ClassDB::bind_method(D_METHOD("get_reflector_paths"), &ReflectorVisibilitySet::get_reflector_paths);
+    ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "reflector_paths", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_reflector_paths", "get_reflector_paths");
+
+    ClassDB::bind_method(D_METHOD("set_reflector_max_coverage_data", "p_coverage"), &ReflectorVisibilitySet::set_reflector_max_coverage_data);
+    ClassDB::bind_method(D_METHOD("get_reflector_max_coverage_data"), &ReflectorVisibilitySet::get_reflector_max_coverage_data);
+    ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "reflector_max_coverage", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_reflector_max_coverage_data", "get_reflector_max_coverage_data");
+
+    ClassDB::bind_method(D_METHOD("set_cell_masks", "p_masks"), &ReflectorVisibilitySet::set_cell_masks);
+    ClassDB::bind_method(D_METHOD("get_cell_masks"), &ReflectorVisibilitySet::get_cell_masks);
+    ADD_PROPERTY(PropertyInfo(Variant::PACKED_BYTE_ARRAY, "cell_masks", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_cell_masks", "get_cell_masks");
+
+    // Bake and lookups - Called from editor tool scripts and at runtime
+    ClassDB::bind_method(D_METHOD("bake", "p_scene_root", "p_sample_points"), &ReflectorVisibilitySet::bake, DEFVAL(PackedVector3Array()));
+    ClassDB::bind_method(D_METHOD("get_cell_index", "p_position"), &ReflectorVisibilitySet::get_cell_index);
+    ClassDB::bind_method(D_METHOD("is_reflector_visible", "p_cell", "p_reflector"), &ReflectorVisibilitySet::is_reflector_visible);
+    ClassDB::bind_method(D_METHOD("find_reflector", "p_path"), &ReflectorVisibilitySet::find_reflector);
+    ClassDB::bind_method(D_METHOD("find_bake_root", "p_scene_root"), &ReflectorVisibilitySet::find_bake_root);
+    ClassDB::bind_method(D_METHOD("get_reflector_count"), &ReflectorVisibilitySet::get_reflector_count);
+    ClassDB::bind_method(D_METHOD("get_reflector_max_coverage", "p_reflector"), &ReflectorVisibilitySet::get_reflector_max_coverage);
+    ClassDB::bind_method(D_METHOD("get_cell_count"), &ReflectorVisibilitySet::get_cell_count);
+}
+
+/**
+ * @brief Moving or resizing the grid invalidates the baked masks
+ */
+void ReflectorVisibilitySet::set_bounds(const AABB &p_bounds)
+{
+    if (p_bounds.abs() == bounds) {
+        return;
+    }
+    bounds = p_bounds.abs();
+    invalidate_masks();
+    emit_changed();
+}
+
+AABB ReflectorVisibilitySet::get_bounds() const { return bounds; }
+
+void ReflectorVisibilitySet::set_cell_size(double p_size)
+{
+    double size = Math::max(p_size, 0.25);
+    if (size == cell_size) {
+        return;
+    }
+    cell_size = size;
+    invalidate_masks();
+    emit_changed();
+}
+
+double ReflectorVisibilitySet::get_cell_size() const { return cell_size; }
+
+void ReflectorVisibilitySet::set_bake_far_distance(double p_distance) { bake_far_distance = Math::max(p_distance, 1.0); }
+double ReflectorVisibilitySet::get_bake_far_distance() const { return bake_far_distance; }
+
+void ReflectorVisibilitySet::set_reflector_paths(const PackedStringArray &p_paths) { reflector_paths = p_paths; rebuild_reflector_lookup(); emit_changed(); }
+PackedStringArray ReflectorVisibilitySet::get_reflector_paths() const { return reflector_paths; }
+
+void ReflectorVisibilitySet::set_bake_root_path(const NodePath &p_path) { bake_root_path = p_path; emit_changed(); }
+NodePath ReflectorVisibilitySet::get_bake_root_path() const { return bake_root_path; }
+
+void ReflectorVisibilitySet::set_baked_cell_counts(const Vector3i &p_counts) { baked_cell_counts = p_counts; }
+Vector3i ReflectorVisibilitySet::get_baked_cell_counts() const { return baked_cell_counts; }
+
+void ReflectorVisibilitySet::set_reflector_max_coverage_data(const PackedFloat32Array &p_coverage) { reflector_max_coverage = p_coverage; }
+PackedFloat32Array ReflectorVisibilitySet::get_reflector_max_coverage_data() const { return reflector_max_coverage; }
+
+void ReflectorVisibilitySet::set_cell_masks(const PackedByteArray &p_masks) { cell_masks = p_masks; emit_changed(); }
+PackedByteArray ReflectorVisibilitySet::get_cell_masks() const { return cell_masks; }
@@ -0,0 +1,93 @@
+#ifndef REFLECTOR_VISIBILITY_SET_H
+#define REFLECTOR_VISIBILITY_SET_H
+
+#include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/aabb.hpp>
+#include <godot_cpp/variant/node_path.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/vector3i.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+
+namespace godot {
+
+    /**
+     * @brief Baked potentially-visible set of PlanarReflectorCPP nodes per camera cell
+     *
+     * The level bounds are split into a grid of cubic cells. For every cell
+     * one bit per reflector records whether the reflector can be seen from
+     * somewhere in that cell. Reflectors are identified by their path from
+     * the node the bake ran on, which is itself stored relative to the
+     * scene. Runtime lookups are a grid index and a bit test.
+     */
+    class ReflectorVisibilitySet : public Resource
+    {
+        GDCLASS(ReflectorVisibilitySet, Resource)
+
+    private:
+        AABB bounds = AABB(Vector3(-50, -10, -50), Vector3(100, 20, 100));
+        double cell_size = 4.0;
+        double bake_far_distance = 500.0;
+        NodePath bake_root_path = NodePath(".");    // Baked root, relative to the scene (absolute outside it)
+        Vector3i baked_cell_counts;                 // Grid the masks were baked for
+        PackedStringArray reflector_paths;
+        PackedFloat32Array reflector_max_coverage;  // Largest screen fraction seen from any sample
+        PackedByteArray cell_masks;                 // cell_count * mask_stride bytes
+        HashMap<String, int> reflector_lookup;      // Rebuilt from reflector_paths
+
+        Vector3i get_cell_counts() const;
+        int get_mask_stride() const;
+        bool has_valid_masks() const;
+        void invalidate_masks();
+        void rebuild_reflector_lookup();
+
+    protected:
+        static void _bind_methods();
+
+    public:
+        static const int BAKE_BUFFER_SIZE = 64;     // Occlusion buffer per cube face during the bake
+
+        // Runtime lookups
+        int get_cell_index(const Vector3 &p_position) const;
+        bool is_reflector_visible(int p_cell, int p_reflector) const;
+        int find_reflector(const NodePath &p_path) const;
+        Node *find_bake_root(Node *p_scene_root) const;
+        int get_reflector_count() const;
+        double get_reflector_max_coverage(int p_reflector) const;
+        int get_cell_count() const;
+
+        // Editor bake
+        Error bake(Node *p_scene_root, const PackedVector3Array &p_sample_points);
+
+        // Setters and getters
+        void set_bounds(const AABB &p_bounds);
+        AABB get_bounds() const;
+
+        void set_cell_size(double p_size);
+        double get_cell_size() const;
+
+        void set_bake_far_distance(double p_distance);
+        double get_bake_far_distance() const;
+
+        void set_bake_root_path(const NodePath &p_path);
+        NodePath get_bake_root_path() const;
+
+        void set_baked_cell_counts(const Vector3i &p_counts);
+        Vector3i get_baked_cell_counts() const;
+
+        void set_reflector_paths(const PackedStringArray &p_paths);
+        PackedStringArray get_reflector_paths() const;
+
+        void set_reflector_max_coverage_data(const PackedFloat32Array &p_coverage);
+        PackedFloat32Array get_reflector_max_coverage_data() const;
+
+        void set_cell_masks(const PackedByteArray &p_masks);
+        PackedByteArray get_cell_masks() const;
+    };
+
+}
+
+#endif // REFLECTOR_VISIBILITY_SET_H
@@ -2,6 +2,7 @@
 
 //Include the other headers you want to register with Godot
 #include "PlanarReflectorCPP.h"
+#include "ReflectorVisibilitySet.h"
 
 
 //your Godot and GDExtensions base classes
@@ -22,6 +23,7 @@ void initialize_planar_reflector_types(ModuleInitializationLevel p_level)
 
     // Register classes
     ClassDB::register_class<PlanarReflectorCPP>();
+    ClassDB::register_class<ReflectorVisibilitySet>();
 
     
     // UtilityFunctions::print("Both PlanarReflectorCPP and ReflectionEffectPrePass registered at SCENE level");
@@ -34,6 +36,8 @@ void unitialize_planar_reflector_types(ModuleInitializationLevel p_level)
         return;
     }
     // Cleanup both classes
+    PlanarReflectorCPP::release_shared_resources();
+    PlanarReflectorCPP::release_derived_environments();
 }
 
 extern "C" {
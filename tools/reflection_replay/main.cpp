@@ -0,0 +1,275 @@
+/**
+ * @file main.cpp
+ * @brief Offline replay of PlanarReflectorCPP trace captures with alternative settings
+ * 
+ * Reads one or more .prtr files written by PlanarReflectorCPP::start_trace_capture(),
+ * re-runs the update scheduling and resolution LOD from ReflectionScheduling.h with the
+ * given overrides and compares the result with what was recorded. No engine needed.
+ * 
+ * Build:  g++ -std=c++17 -O2 -I../../src main.cpp -o reflection_replay
+ * Usage:  reflection_replay [options] trace.prtr [more.prtr ...]
+ *   --update-frequency N     Update every Nth reflector frame
+ *   --lod / --no-lod         Force distance LOD on or off
+ *   --lod-near D             Full resolution up to this distance
+ *   --lod-far D              Minimum LOD resolution from this distance
+ *   --lod-multiplier M       Resolution factor at lod-far
+ *   --roughness-min-scale S  Resolution factor for fully rough surfaces
+ *   --min-size N             Minimum target edge in pixels
+ *   --update-mode MODE       recorded (default), always or on-demand
+ *   --skip-invisible         Do not render reflectors outside the camera frustum
+ * 
+ * Continuous (always) targets render every frame whatever the update frequency,
+ * which only throttles camera moves; on-demand targets render only on updates.
+ */
+
+#include "ReflectionScheduling.h"
+#include "ReflectionTrace.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief Settings overrides from the command line (negative / -1 = keep the recorded value)
+     */
+    enum ReplayUpdateMode {
+        REPLAY_MODE_RECORDED,   // Each frame keeps the mode it was recorded with
+        REPLAY_MODE_ALWAYS,
+        REPLAY_MODE_ON_DEMAND,
+    };
+
+    struct ReplayOverrides {
+        int update_frequency = -1;
+        ReplayUpdateMode update_mode = REPLAY_MODE_RECORDED;
+        int use_lod = -1;
+        double lod_distance_near = -1.0;
+        double lod_distance_far = -1.0;
+        double lod_resolution_multiplier = -1.0;
+        double roughness_min_resolution_scale = -1.0;
+        int min_size = -1;
+        bool skip_invisible = false;
+    };
+
+    struct ReplayTrace {
+        std::string path;
+        ReflectionTraceHeader header;
+        std::vector<ReflectionTraceRecord> records;
+    };
+
+    /**
+     * @brief Totals for one side of the comparison
+     */
+    struct ReplayTotals {
+        uint64_t renders = 0;
+        uint64_t pixels = 0;
+        uint64_t worst_frame_pixels = 0;
+        uint64_t worst_frame = 0;
+        std::map<uint64_t, uint64_t> pixels_per_frame;
+
+        void add(uint64_t frame, uint64_t pixels_rendered)
+        {
+            renders++;
+            pixels += pixels_rendered;
+            uint64_t &frame_pixels = pixels_per_frame[frame];
+            frame_pixels += pixels_rendered;
+            if (frame_pixels > worst_frame_pixels) {
+                worst_frame_pixels = frame_pixels;
+                worst_frame = frame;
+            }
+        }
+    };
+
+    bool load_trace(const char *path, ReplayTrace &r_trace)
+    {
+        FILE *file = fopen(path, "rb");
+        if (!file) {
+            fprintf(stderr, "reflection_replay: cannot open %s\n", path);
+            return false;
+        }
+
+        r_trace.path = path;
+        bool valid = fread(&r_trace.header, sizeof(r_trace.header), 1, file) == 1 &&
+                memcmp(r_trace.header.magic, REFLECTION_TRACE_MAGIC, 4) == 0 &&
+                r_trace.header.version == REFLECTION_TRACE_VERSION &&
+                r_trace.header.record_size == sizeof(ReflectionTraceRecord);
+        if (!valid) {
+            fprintf(stderr, "reflection_replay: %s is not a version %d reflection trace\n", path, REFLECTION_TRACE_VERSION);
+            fclose(file);
+            return false;
+        }
+
+        ReflectionTraceRecord record;
+        while (fread(&record, sizeof(record), 1, file) == 1) {
+            r_trace.records.push_back(record);
+        }
+        fclose(file);
+        return true;
+    }
+
+    double distance_to_camera(const ReflectionTraceRecord &record)
+    {
+        double dx = record.reflector_position[0] - record.camera_position[0];
+        double dy = record.reflector_position[1] - record.camera_position[1];
+        double dz = record.reflector_position[2] - record.camera_position[2];
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    /**
+     * @brief Re-runs scheduling and sizing for one trace and adds the renders to the totals
+     */
+    void replay_trace(const ReplayTrace &trace, const ReplayOverrides &overrides, ReplayTotals &r_recorded, ReplayTotals &r_replayed)
+    {
+        const ReflectionTraceHeader &header = trace.header;
+        int update_frequency = overrides.update_frequency >= 0 ? overrides.update_frequency : header.update_frequency;
+        bool use_lod = overrides.use_lod >= 0 ? overrides.use_lod != 0 : header.use_lod != 0;
+        double lod_near = overrides.lod_distance_near >= 0.0 ? overrides.lod_distance_near : header.lod_distance_near;
+        double lod_far = overrides.lod_distance_far >= 0.0 ? overrides.lod_distance_far : header.lod_distance_far;
+        double lod_multiplier = overrides.lod_resolution_multiplier >= 0.0 ? overrides.lod_resolution_multiplier : header.lod_resolution_multiplier;
+        double min_scale = overrides.roughness_min_resolution_scale > 0.0 ? overrides.roughness_min_resolution_scale : header.roughness_min_resolution_scale;
+        int32_t min_size = overrides.min_size >= 0 ? overrides.min_size : header.min_size;
+
+        for (const ReflectionTraceRecord &record : trace.records) {
+            // What the session actually rendered
+            if (record.flags & REFLECTION_TRACE_RENDERED) {
+                r_recorded.add(record.engine_frame, (uint64_t)record.chosen_width * (uint64_t)record.chosen_height);
+            }
+
+            // Evicted and empty reflectors render nothing regardless of settings
+            if (record.flags & (REFLECTION_TRACE_EVICTED | REFLECTION_TRACE_EMPTY)) {
+                continue;
+            }
+            if (overrides.skip_invisible && !(record.flags & REFLECTION_TRACE_VISIBLE)) {
+                continue;
+            }
+
+            bool continuous = overrides.update_mode == REPLAY_MODE_RECORDED ?
+                    (record.flags & REFLECTION_TRACE_CONTINUOUS) != 0 : overrides.update_mode == REPLAY_MODE_ALWAYS;
+            bool cut = (record.flags & REFLECTION_TRACE_CAMERA_CUT) != 0;
+            if (!continuous && !cut && !ReflectionScheduling::is_update_frame(record.reflector_frame, update_frequency)) {
+                continue;
+            }
+
+            double factor = 1.0;
+            if (use_lod) {
+                factor *= ReflectionScheduling::lod_factor(distance_to_camera(record), lod_near, lod_far, lod_multiplier);
+            }
+            factor *= ReflectionScheduling::roughness_factor(record.roughness, min_scale);
+
+            int32_t width = ReflectionScheduling::scale_edge(record.base_width, factor, min_size);
+            int32_t height = ReflectionScheduling::scale_edge(record.base_height, factor, min_size);
+            r_replayed.add(record.engine_frame, (uint64_t)width * (uint64_t)height);
+        }
+    }
+
+    void print_totals(const char *label, const ReplayTotals &totals, size_t frame_count)
+    {
+        double average = frame_count > 0 ? (double)totals.pixels / (double)frame_count : 0.0;
+        printf("%-10s renders %10llu   pixels %14llu   avg/frame %12.0f   worst frame %llu (%llu px)\n", label,
+                (unsigned long long)totals.renders, (unsigned long long)totals.pixels, average,
+                (unsigned long long)totals.worst_frame, (unsigned long long)totals.worst_frame_pixels);
+    }
+
+    void print_usage()
+    {
+        fprintf(stderr, "usage: reflection_replay [--update-frequency N] [--lod|--no-lod] [--lod-near D] [--lod-far D]\n"
+                        "                         [--lod-multiplier M] [--roughness-min-scale S] [--min-size N]\n"
+                        "                         [--update-mode recorded|always|on-demand]\n"
+                        "                         [--skip-invisible] trace.prtr [more.prtr ...]\n");
+    }
+
+}
+
+int main(int argc, char **argv)
+{
+    ReplayOverrides overrides;
+    std::vector<ReplayTrace> traces;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--update-frequency" && has_value) {
+            overrides.update_frequency = atoi(argv[++i]);
+        } else if (arg == "--lod") {
+            overrides.use_lod = 1;
+        } else if (arg == "--no-lod") {
+            overrides.use_lod = 0;
+        } else if (arg == "--lod-near" && has_value) {
+            overrides.lod_distance_near = atof(argv[++i]);
+        } else if (arg == "--lod-far" && has_value) {
+            overrides.lod_distance_far = atof(argv[++i]);
+        } else if (arg == "--lod-multiplier" && has_value) {
+            overrides.lod_resolution_multiplier = atof(argv[++i]);
+        } else if (arg == "--roughness-min-scale" && has_value) {
+            overrides.roughness_min_resolution_scale = atof(argv[++i]);
+        } else if (arg == "--min-size" && has_value) {
+            overrides.min_size = atoi(argv[++i]);
+        } else if (arg == "--update-mode" && has_value) {
+            std::string mode = argv[++i];
+            if (mode == "recorded") {
+                overrides.update_mode = REPLAY_MODE_RECORDED;
+            } else if (mode == "always") {
+                overrides.update_mode = REPLAY_MODE_ALWAYS;
+            } else if (mode == "on-demand") {
+                overrides.update_mode = REPLAY_MODE_ON_DEMAND;
+            } else {
+                print_usage();
+                return 2;
+            }
+        } else if (arg == "--skip-invisible") {
+            overrides.skip_invisible = true;
+        } else if (arg.size() > 2 && arg.compare(0, 2, "--") == 0) {
+            print_usage();
+            return 2;
+        } else {
+            ReplayTrace trace;
+            if (!load_trace(argv[i], trace)) {
+                return 1;
+            }
+            traces.push_back(trace);
+        }
+    }
+
+    if (traces.empty()) {
+        print_usage();
+        return 2;
+    }
+
+    ReplayTotals recorded;
+    ReplayTotals replayed;
+    std::map<uint64_t, uint64_t> cpu_usec_per_frame;
+    uint64_t worst_cpu_usec = 0;
+    uint64_t worst_cpu_frame = 0;
+
+    for (const ReplayTrace &trace : traces) {
+        printf("%s: reflector %llu, %zu frames\n", trace.path.c_str(), (unsigned long long)trace.header.reflector_id, trace.records.size());
+        replay_trace(trace, overrides, recorded, replayed);
+
+        // Recorded CPU cost, summed over all reflectors per engine frame
+        for (const ReflectionTraceRecord &record : trace.records) {
+            uint64_t &frame_usec = cpu_usec_per_frame[record.engine_frame];
+            frame_usec += record.update_usec;
+            if (frame_usec > worst_cpu_usec) {
+                worst_cpu_usec = frame_usec;
+                worst_cpu_frame = record.engine_frame;
+            }
+        }
+    }
+
+    size_t frame_count = cpu_usec_per_frame.size();
+    printf("\n");
+    print_totals("recorded", recorded, frame_count);
+    print_totals("replayed", replayed, frame_count);
+    if (recorded.pixels > 0) {
+        printf("pixel ratio replayed/recorded: %.3f\n", (double)replayed.pixels / (double)recorded.pixels);
+    }
+    printf("worst recorded CPU frame: %llu (%llu us across all reflectors)\n",
+            (unsigned long long)worst_cpu_frame, (unsigned long long)worst_cpu_usec);
+    return 0;
+}